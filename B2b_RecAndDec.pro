@@ -26,22 +26,44 @@ DEFINES += QT_DEPRECATED_WARNINGS
 
 SOURCES += \
     Communicator.cpp \
+    CorrectionFusion.cpp \
+    CorrectionMonitor.cpp \
+    CorrectionTimelineWidget.cpp \
     Decoder.cpp \
+    EpochArena.cpp \
+    EventLog.cpp \
+    HeadlessRunner.cpp \
     Reciver.cpp \
+    SerialReader.cpp \
+    SoakTest.cpp \
     main.cpp \
     mainwindow.cpp \
     utils.cpp
 
 HEADERS += \
     Communicator.h \
+    CorrectionFusion.h \
+    CorrectionMonitor.h \
+    CorrectionTimelineWidget.h \
     Decoder.h \
+    EpochArena.h \
+    EventLog.h \
+    HeadlessRunner.h \
     Reciver.h \
+    SerialReader.h \
+    SoakTest.h \
     mainwindow.h \
     utils.h
 
 FORMS += \
     mainwindow.ui
 
+# 进程内存统计（Utils::residentSetBytes）
+win32: LIBS += -lpsapi
+
+# 浸泡测试堆分配计数（qmake CONFIG+=soak_heap_count），在malloc层统计全部堆分配，仅用于测试构建
+soak_heap_count: DEFINES += B2B_SOAK_HEAP_COUNT
+
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
@@ -1,4 +1,6 @@
 ﻿#include "Communicator.h"
+#include "utils.h"
+#include "EventLog.h"
 #include <QFileInfo>
 #include <QDebug>
 
@@ -55,7 +57,7 @@ bool Communicator::startCommunication(CommunicationType type, const Config &conf
         initSuccess = initSerialPortCommunication(config);
         break;
     default:
-        emit communicateRecoder("不支持的通讯类型");
+        logEvent(EventLog::Code::UnsupportedType, {static_cast<int>(type)});
         return false;
     }
 
@@ -63,7 +65,7 @@ bool Communicator::startCommunication(CommunicationType type, const Config &conf
     m_isRunning = initSuccess;
     emit stateChanged(m_isRunning);
     if (!initSuccess) {
-        emit communicateRecoder(QString("启动%1模式失败").arg(QString::fromStdString(std::to_string(static_cast<int>(type)))));
+        logEvent(EventLog::Code::StartFailed, {static_cast<int>(type)});
     }
 
     return initSuccess;
@@ -89,7 +91,7 @@ void Communicator::stopCommunication()
     // 更新状态并发送信号
     m_isRunning = false;
     emit stateChanged(false);
-    emit communicateRecoder("通讯已停止");
+    logEvent(EventLog::Code::Stopped);
 }
 
 /**
@@ -99,17 +101,17 @@ void Communicator::stopCommunication()
  */
 bool Communicator::initFileCommunication(const Config &config)
 {
-    emit communicateRecoder("初始化文件通讯");
+    logEvent(EventLog::Code::FileInit);
     // 检查文件路径是否有效
     if (config.filePath.isEmpty()) {
-        emit communicateRecoder("文件路径为空");
+        logEvent(EventLog::Code::FilePathEmpty);
         return false;
     }
 
     // 创建文件对象
     m_file = new QFile(config.filePath, this);
     if (!m_file->open(QIODevice::ReadOnly)) {
-        emit communicateRecoder(QString("文件打开失败：%1").arg(m_file->errorString()));
+        logEvent(EventLog::Code::FileOpenFailed, m_file->errorString(), {m_file->error()});
         delete m_file;
         m_file = nullptr;
         return false;
@@ -119,7 +121,7 @@ bool Communicator::initFileCommunication(const Config &config)
     m_fileReadTimer->setInterval(config.readInterval);
     m_fileReadTimer->start();
 
-    emit communicateRecoder(QString("文件模式启动成功，路径：%1").arg(config.filePath));
+    logEvent(EventLog::Code::FileStarted, QFileInfo(config.filePath).fileName());
     return true;
 }
 
@@ -130,7 +132,7 @@ bool Communicator::initFileCommunication(const Config &config)
  */
 bool Communicator::initTcpClientCommunication(const Config &config)
 {
-    emit communicateRecoder("初始化Tcp通讯");
+    logEvent(EventLog::Code::TcpInit);
     // 创建TCP客户端套接字
     m_tcpSocket = new QTcpSocket(this);
 
@@ -155,7 +157,7 @@ bool Communicator::initTcpClientCommunication(const Config &config)
             &QTcpSocket::disconnected,
             this,
             [this]() {
-                emit communicateRecoder("TCP客户端已断开连接");
+                logEvent(EventLog::Code::TcpDisconnected);
                 stopCommunication();});
 
     // 连接到TCP服务器
@@ -173,36 +175,53 @@ bool Communicator::initTcpClientCommunication(const Config &config)
  */
 bool Communicator::initSerialPortCommunication(const Config &config)
 {
-    emit communicateRecoder("初始化串口通讯");
+    logEvent(EventLog::Code::SerialInit);
     // 检查串口号是否有效
     if (config.serialPortName.isEmpty()) {
-        emit communicateRecoder("串口号为空");
+        logEvent(EventLog::Code::SerialPortEmpty);
         return false;
     }
 
-    // 创建串口对象
-    m_serialPort = new QSerialPort(this);
-    m_serialPort->setPortName(config.serialPortName);
-    m_serialPort->setBaudRate(config.baudRate);
-    m_serialPort->setDataBits(config.dataBits);
-    m_serialPort->setParity(config.parity);
-    m_serialPort->setStopBits(config.stopBits);
-    m_serialPort->setFlowControl(config.flowControl);
-
-    // 打开串口（读写模式）
-    if (!m_serialPort->open(QIODevice::ReadWrite)) {
-        emit communicateRecoder(QString("串口打开失败：%1").arg(m_serialPort->errorString()));
-        delete m_serialPort;
-        m_serialPort = nullptr;
+    // 串口参数
+    SerialReader::Settings settings;
+    settings.portName = config.serialPortName;
+    settings.baudRate = config.baudRate;
+    settings.dataBits = config.dataBits;
+    settings.parity = config.parity;
+    settings.stopBits = config.stopBits;
+    settings.flowControl = config.flowControl;
+    settings.portBufferSize = config.serialReadBufferSize;
+    settings.chunkSize = config.serialChunkSize;
+    settings.channel = m_channel;
+
+    // 创建串口读取对象并移入独立线程（无父对象，由releaseSerialReader释放）
+    m_serialDispatch = DispatchLatencyStats();
+    m_serialThread = new QThread(this);
+    m_serialReader = new SerialReader();
+    m_serialReader->setSettings(settings);
+    m_serialReader->moveToThread(m_serialThread);
+
+    // 绑定信号槽（跨线程，队列连接）；数据块附带会话号，
+    // 断开连接不会移除已投递的队列事件，停止后立即重启时据此丢弃上次会话的残留数据
+    const quint32 session = ++m_serialSession;
+    connect(m_serialReader, &SerialReader::dataRead, this, [this, session](const QByteArray &rawData, qint64 rxTimeNs) {
+        onSerialDataRead(session, rawData, rxTimeNs);
+    });
+    connect(m_serialReader, &SerialReader::readerError, this, &Communicator::onSerialReaderError);
+
+    m_serialThread->start(QThread::TimeCriticalPriority);
+
+    // 在串口线程中打开串口，阻塞等待结果
+    bool opened = false;
+    QMetaObject::invokeMethod(m_serialReader, "open", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, opened));
+    if (!opened) {
+        releaseSerialReader();
         return false;
     }
 
-    // 绑定信号槽
-    connect(m_serialPort, &QSerialPort::readyRead, this, &Communicator::onSerialPortDataReady);
-    connect(m_serialPort, QOverload<QSerialPort::SerialPortError>::of(&QSerialPort::errorOccurred),
-            this, &Communicator::onSerialPortError);
-
-    emit communicateRecoder(QString("串口启动成功，端口：%1，波特率：%2").arg(config.serialPortName).arg(config.baudRate));
+    logEvent(EventLog::Code::SerialStarted, config.serialPortName,
+             {config.baudRate, config.dataBits, config.parity, config.stopBits * 10 + config.flowControl});
     return true;
 }
 
@@ -211,7 +230,7 @@ bool Communicator::initSerialPortCommunication(const Config &config)
  */
 void Communicator::releaseAllResources()
 {
-    emit communicateRecoder("释放所有资源");
+    logEvent(EventLog::Code::ResourcesReleased);
     // 释放文件资源
     if (m_file) {
         m_file->close();
@@ -227,13 +246,38 @@ void Communicator::releaseAllResources()
     }
 
     // 释放串口资源
-    if (m_serialPort) {
-        m_serialPort->close();
-        m_serialPort->deleteLater();
-        m_serialPort = nullptr;
+    if (m_serialReader) {
+        logEvent(EventLog::Code::SerialDispatchLatency,
+                 {static_cast<qint64>(m_serialDispatch.chunks),
+                  m_serialDispatch.chunks ? m_serialDispatch.totalNs / static_cast<qint64>(m_serialDispatch.chunks) : 0,
+                  m_serialDispatch.minNs, m_serialDispatch.maxNs});
+        releaseSerialReader();
     }
 }
 
+/**
+ * @brief 释放串口线程及读取对象
+ */
+void Communicator::releaseSerialReader()
+{
+    if (m_serialReader) {
+        // 在串口线程中关闭串口，阻塞等待完成
+        QMetaObject::invokeMethod(m_serialReader, "close", Qt::BlockingQueuedConnection);
+        m_serialReader->disconnect(this);
+    }
+
+    if (m_serialThread) {
+        m_serialThread->quit();
+        m_serialThread->wait();
+        delete m_serialThread;
+        m_serialThread = nullptr;
+    }
+
+    // 线程已结束，可直接释放
+    delete m_serialReader;
+    m_serialReader = nullptr;
+}
+
 // ========== 槽函数实现 ==========
 
 /**
@@ -251,10 +295,10 @@ void Communicator::onFileReadTimerTimeout()
     if (rawData.isEmpty()) {
         // 读取到文件末尾
         if (m_file->atEnd()) {
-            emit communicateRecoder("文件读取完毕");
+            logEvent(EventLog::Code::FileEnd);
             stopCommunication();
         } else {
-            emit communicateRecoder(QString("文件读取失败：%1").arg(m_file->errorString()));
+            logEvent(EventLog::Code::FileReadFailed, m_file->errorString(), {m_file->error()});
         }
         return;
     }
@@ -268,8 +312,7 @@ void Communicator::onFileReadTimerTimeout()
  */
 void Communicator::onTcpClientConnected()
 {
-    emit communicateRecoder(QString("TCP客户端连接成功：%1:%2")
-                       .arg(m_currentConfig.tcpIp).arg(m_currentConfig.tcpPort));
+    logEvent(EventLog::Code::TcpConnected, m_currentConfig.tcpIp, {m_currentConfig.tcpPort});
 }
 
 /**
@@ -278,8 +321,7 @@ void Communicator::onTcpClientConnected()
  */
 void Communicator::onTcpClientError(QAbstractSocket::SocketError socketError)
 {
-    Q_UNUSED(socketError)
-    emit communicateRecoder(QString("TCP客户端错误：%1").arg(m_tcpSocket->errorString()));
+    logEvent(EventLog::Code::TcpError, m_tcpSocket->errorString(), {socketError});
     stopCommunication();
 }
 
@@ -305,7 +347,7 @@ void Communicator::onTcpDataReady()
  */
 void Communicator::onTcpClientDisconnected()
 {
-    emit communicateRecoder("TCP客户端已断开连接");
+    logEvent(EventLog::Code::TcpDisconnected);
     if (m_tcpSocket) {
         m_tcpSocket->deleteLater();
         m_tcpSocket = nullptr;
@@ -314,30 +356,58 @@ void Communicator::onTcpClientDisconnected()
 
 /**
  * @brief 串口数据就绪槽函数
+ * @param session 串口会话号
+ * @param rawData 原始数据
+ * @param rxTimeNs 数据到达时刻
  */
-void Communicator::onSerialPortDataReady()
+void Communicator::onSerialDataRead(quint32 session, const QByteArray &rawData, qint64 rxTimeNs)
 {
-    if (!m_serialPort || !m_serialPort->isOpen()) {
+    if (!m_serialReader || session != m_serialSession || rawData.isEmpty()) {
         return;
     }
 
-    // 读取所有可用串口数据
-    QByteArray rawData = m_serialPort->readAll();
-    if (!rawData.isEmpty()) {
-        emit dataReady(rawData);
+    // 统计读取线程到分发的延迟
+    const qint64 latencyNs = Utils::steadyNowNs() - rxTimeNs;
+    if (m_serialDispatch.chunks == 0 || latencyNs < m_serialDispatch.minNs) {
+        m_serialDispatch.minNs = latencyNs;
+    }
+    if (latencyNs > m_serialDispatch.maxNs) {
+        m_serialDispatch.maxNs = latencyNs;
     }
+    m_serialDispatch.totalNs += latencyNs;
+    m_serialDispatch.bytes += static_cast<quint64>(rawData.size());
+    ++m_serialDispatch.chunks;
+
+    emit dataReady(rawData);
 }
 
 /**
  * @brief 串口错误槽函数
- * @param error 错误码
+ * @param error 错误码（已由串口线程写入日志）
  */
-void Communicator::onSerialPortError(QSerialPort::SerialPortError error)
+void Communicator::onSerialReaderError(int error)
 {
-    if (error == QSerialPort::NoError) {
-        return;
-    }
-
-    emit communicateRecoder(QString("串口错误：%1").arg(m_serialPort->errorString()));
+    Q_UNUSED(error)
     stopCommunication();
 }
+
+/**
+ * @brief 写入通讯器事件
+ * @param code 事件码
+ * @param args 数值字段
+ */
+void Communicator::logEvent(EventLog::Code code, std::initializer_list<qint64> args)
+{
+    EventLog::instance().record(EventLog::Source::Communicator, code, args, m_channel);
+}
+
+/**
+ * @brief 写入通讯器事件（带附加文本）
+ * @param code 事件码
+ * @param detail 附加文本
+ * @param args 数值字段
+ */
+void Communicator::logEvent(EventLog::Code code, const QString &detail, std::initializer_list<qint64> args)
+{
+    EventLog::instance().record(EventLog::Source::Communicator, code, detail, args, m_channel);
+}
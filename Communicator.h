@@ -7,13 +7,17 @@
 #include <QTcpServer>
 #include <QSerialPort>
 #include <QTimer>
+#include <QThread>
 #include <QByteArray>
 
+#include "SerialReader.h"
+#include "EventLog.h"
+
 /**
  * @class Communicator
  * @brief 通讯层核心类，统一封装文件、TCP服务器（客户端模式）、串口三种种数据输入方式
  * @details 对外提供统一的启动/停止接口，内部根据配置适配不同通讯方式，
- *          原始数据通过dataReady信号对外发送，通讯层日志通过comMsg信号反馈
+ *          原始数据通过dataReady信号对外发送，通讯层日志以结构化事件写入EventLog
  * @author 江鑫海
  * @date 2025-12-05
  */
@@ -54,6 +58,28 @@ public:
         QSerialPort::Parity parity = QSerialPort::NoParity; // 校验位（默认无）
         QSerialPort::StopBits stopBits = QSerialPort::OneStop; // 停止位（默认1位）
         QSerialPort::FlowControl flowControl = QSerialPort::NoFlowControl; // 流控（默认无）
+        qint64 serialReadBufferSize = 0; // 串口内部读缓冲大小（字节，0=不限制）
+        int serialChunkSize = 0;         // 串口单次读取块大小（字节，0=按波特率自动选择）
+    };
+
+    /**
+     * @struct DispatchLatencyStats
+     * @brief 串口读取线程到分发的延迟统计
+     * @details 延迟为串口线程读到数据块至通讯层发出dataReady之间的时间（跨线程队列投递），
+     *          数据块为一次读取的字节，不对应完整电文帧；字节到成帧的延迟需在解码层统计
+     */
+    struct DispatchLatencyStats {
+        quint64 chunks = 0;   // 已发出的数据块数
+        quint64 bytes = 0;    // 已发出的字节数
+        qint64 minNs = 0;     // 最小延迟（ns）
+        qint64 maxNs = 0;     // 最大延迟（ns）
+        qint64 totalNs = 0;   // 延迟累计（ns）
+
+        /**
+         * @brief 平均延迟
+         * @return double 平均延迟（us），无数据返回0
+         */
+        double meanUs() const { return chunks ? totalNs / 1000.0 / chunks : 0.0; }
     };
 
     /**
@@ -88,6 +114,24 @@ public:
      */
     CommunicationType currentType() const { return m_currentType; }
 
+    /**
+     * @brief 获取串口读取线程到分发的延迟统计
+     * @return DispatchLatencyStats 自本次串口通讯启动以来的统计
+     */
+    DispatchLatencyStats serialDispatchLatency() const { return m_serialDispatch; }
+
+    /**
+     * @brief 设置通道号
+     * @param channel 通道号（多数据源融合时为数据源序号+1，单数据源为0），写入本通讯器产生的事件
+     */
+    void setChannel(int channel) { m_channel = channel; }
+
+    /**
+     * @brief 获取通道号
+     * @return int 通道号
+     */
+    int channel() const { return m_channel; }
+
 signals:
     /**
      * @brief 原始数据就绪信号
@@ -96,13 +140,6 @@ signals:
      */
     void dataReady(const QByteArray &rawData);
 
-    /**
-     * @brief 通讯器日志信号
-     * @param comMsg 错误描述信息
-     * @details 通讯过程中所有日志均通过此信号对外反馈
-     */
-    void communicateRecoder(const QString &comMsg);
-
     /**
      * @brief 通讯状态变化信号
      * @param isRunning true=通讯中，false=已停止
@@ -145,15 +182,19 @@ private slots:
     // ========== 串口模式槽函数 ==========
     /**
      * @brief 串口数据就绪槽函数
-     * @details 串口模式下，有数据可读时触发
+     * @param session 发出该数据块的串口会话号
+     * @param rawData 串口线程读取到的数据
+     * @param rxTimeNs 数据到达时刻（Utils::steadyNowNs）
+     * @details 串口模式下，串口线程读到数据后触发，统计延迟并转发dataReady；
+     *          会话号与当前会话不符的数据块（上次会话已投递、尚未处理的队列事件）直接丢弃
      */
-    void onSerialPortDataReady();
+    void onSerialDataRead(quint32 session, const QByteArray &rawData, qint64 rxTimeNs);
 
     /**
      * @brief 串口错误槽函数
-     * @param error 串口错误码
+     * @param error 串口错误码（QSerialPort::SerialPortError）
      */
-    void onSerialPortError(QSerialPort::SerialPortError error);
+    void onSerialReaderError(int error);
 
 private:
     /**
@@ -183,10 +224,33 @@ private:
      */
     void releaseAllResources();
 
+    /**
+     * @brief 释放串口线程及读取对象
+     * @details 在串口线程中关闭串口后结束线程
+     */
+    void releaseSerialReader();
+
+    /**
+     * @brief 写入通讯器事件
+     * @param code 事件码
+     * @param args 数值字段（最多4个）
+     * @details 仅记录事件码与数值，显示时才格式化
+     */
+    void logEvent(EventLog::Code code, std::initializer_list<qint64> args = {});
+
+    /**
+     * @brief 写入通讯器事件（带附加文本）
+     * @param code 事件码
+     * @param detail 附加文本（如错误描述，仅用于低频事件）
+     * @param args 数值字段（最多4个）
+     */
+    void logEvent(EventLog::Code code, const QString &detail, std::initializer_list<qint64> args = {});
+
     // 核心成员变量
     CommunicationType m_currentType;  // 当前通讯类型
     Config m_currentConfig;           // 当前通讯配置
     bool m_isRunning = false;         // 通讯是否正在运行
+    int m_channel = 0;                // 通道号（事件日志中区分多个通讯器）
 
     // 文件模式成员
     QFile *m_file = nullptr;          // 文件对象
@@ -196,7 +260,10 @@ private:
     QTcpSocket *m_tcpSocket = nullptr;    // TCP套接字（客户端/已连接的客户端）
 
     // 串口模式成员
-    QSerialPort *m_serialPort = nullptr;  // 串口对象
+    QThread *m_serialThread = nullptr;        // 串口读取线程
+    SerialReader *m_serialReader = nullptr;   // 串口读取对象（运行于m_serialThread）
+    quint32 m_serialSession = 0;              // 串口会话号（每次启动串口通讯递增）
+    DispatchLatencyStats m_serialDispatch;    // 串口读取线程到分发的延迟统计
 };
 
 #endif // COMMUNICATOR_H
@@ -0,0 +1,309 @@
+﻿#include "CorrectionFusion.h"
+#include "EventLog.h"
+#include <cmath>
+
+/**
+ * @brief 构造函数实现
+ * @param parent 父对象
+ */
+CorrectionFusion::CorrectionFusion(QObject *parent)
+    : QObject(parent)
+{
+    // 时间桶、键表及取值池一次性分配，取值池仅在单历元取值异常多时扩容（回收时保留容量）
+    m_buckets.resize(kBucketCount);
+    for (Bucket &bucket : m_buckets) {
+        bucket.table.resize(kTableSize);
+        bucket.usedIndexes.reserve(kTableSize);
+        bucket.candidates.reserve(kPoolReserve);
+    }
+}
+
+/**
+ * @brief 注册数据源实现
+ * @return 数据源序号
+ */
+int CorrectionFusion::addSource()
+{
+    if (m_sources.size() >= kMaxSources) {
+        return -1;
+    }
+    m_sources.append(SourceStats());
+    return m_sources.size() - 1;
+}
+
+/**
+ * @brief 输入电文实现
+ * @param source 数据源序号
+ * @param correction 电文
+ */
+void CorrectionFusion::submit(int source, const B2bCorrection &correction)
+{
+    if (source < 0 || source >= m_sources.size()) {
+        return;
+    }
+    SourceStats &stats = m_sources[source];
+    ++stats.received;
+
+    // 按历元整秒定位时间桶
+    const qint64 epoch = static_cast<qint64>(std::floor(correction.epochSod + 0.5)) % 86400;
+    Bucket &bucket = m_buckets[static_cast<int>(epoch % kBucketCount)];
+    if (bucket.epoch != epoch) {
+        // 桶内为更新的历元：该电文已移出时间窗
+        if (bucket.epoch >= 0 && epochDiff(epoch, bucket.epoch) < 0) {
+            ++stats.stale;
+            return;
+        }
+        retireBucket(bucket);
+        bucket.epoch = epoch;
+    }
+
+    B2bCorrection value = correction;
+    value.next = nullptr;
+    const quint32 key = entryKey(correction.slot, correction.msgType);
+    const quint32 voter = 1u << source;
+
+    Entry *entry = findEntry(bucket, key);
+    if (!entry) {
+        // 键表已满（异常情况），不做去重直接转发
+        ++stats.forwarded;
+        emit fused(value, source, false);
+        return;
+    }
+
+    // 该键在本历元的首条电文：早于已转发历元则丢弃，否则立即转发
+    if (entry->candidateCount == 0) {
+        QHash<quint32, qint64>::iterator latest = m_latestEpoch.find(key);
+        if (latest != m_latestEpoch.end() && epochDiff(epoch, latest.value()) < 0) {
+            entry->used = false;
+            bucket.usedIndexes.removeLast();
+            ++stats.stale;
+            return;
+        }
+        m_latestEpoch.insert(key, epoch);
+
+        entry->current = addCandidate(bucket, *entry, value, source, voter);
+        entry->seen = voter;
+        ++stats.forwarded;
+        emit fused(value, source, false);
+        return;
+    }
+
+    // 已撤回投票的数据源本历元不再参与
+    if (entry->conflicted & voter) {
+        return;
+    }
+
+    int match = -1;
+    for (int i = entry->firstCandidate; i >= 0; i = bucket.candidates[i].next) {
+        if (sameValue(bucket.candidates[i].value, value)) {
+            match = i;
+            break;
+        }
+    }
+
+    // 同一数据源再次给出该键：取值相同视为重复，取值不同则撤回其全部投票
+    if (entry->seen & voter) {
+        if (match >= 0 && (bucket.candidates[match].voters & voter)) {
+            ++stats.duplicates;
+            return;
+        }
+        entry->conflicted |= voter;
+        for (int i = entry->firstCandidate; i >= 0; i = bucket.candidates[i].next) {
+            bucket.candidates[i].voters &= ~voter;
+        }
+        ++stats.inconsistent;
+        EventLog::instance().record(EventLog::Source::Fusion, EventLog::Code::FusionSourceConflict,
+                                    {source, correction.slot, correction.msgType, epoch});
+        emit sourceInconsistent(source, correction.slot, correction.msgType, correction.epochSod);
+        resolve(bucket, *entry);
+        return;
+    }
+    entry->seen |= voter;
+
+    // 其余数据源：投票给一致的取值，或作为新的一种取值单独计票
+    if (match >= 0) {
+        bucket.candidates[match].voters |= voter;
+        if (match == entry->current) {
+            ++stats.duplicates;
+        }
+    } else {
+        addCandidate(bucket, *entry, value, source, voter);
+    }
+    resolve(bucket, *entry);
+}
+
+/**
+ * @brief 回收全部时间桶实现
+ */
+void CorrectionFusion::flush()
+{
+    for (Bucket &bucket : m_buckets) {
+        retireBucket(bucket);
+        bucket.epoch = -1;
+    }
+}
+
+// ========== 私有函数实现 ==========
+
+/**
+ * @brief 查找或创建键实现
+ * @details 线性探测开放寻址
+ */
+CorrectionFusion::Entry *CorrectionFusion::findEntry(Bucket &bucket, quint32 key)
+{
+    int index = static_cast<int>((key * 2654435761u) >> 22) & (kTableSize - 1);
+    for (int probe = 0; probe < kTableSize; ++probe) {
+        Entry &entry = bucket.table[index];
+        if (!entry.used) {
+            entry.used = true;
+            entry.key = key;
+            entry.candidateCount = 0;
+            entry.firstCandidate = -1;
+            entry.current = -1;
+            entry.seen = 0;
+            entry.conflicted = 0;
+            bucket.usedIndexes.append(index);
+            return &entry;
+        }
+        if (entry.key == key) {
+            return &entry;
+        }
+        index = (index + 1) & (kTableSize - 1);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 回收时间桶实现
+ * @details 每种落败取值分别与当前转发值比较：转发值得票严格更多时，该取值的数据源记为不一致；
+ *          平票时记为争议键，不归咎任何数据源
+ */
+void CorrectionFusion::retireBucket(Bucket &bucket)
+{
+    for (int index : bucket.usedIndexes) {
+        Entry &entry = bucket.table[index];
+        const Candidate &winner = bucket.candidates[entry.current];
+        const B2bCorrection &value = winner.value;
+        const int winnerVotes = qPopulationCount(winner.voters);
+
+        quint32 losers = 0;
+        quint32 disputed = 0;
+        for (int i = entry.firstCandidate; i >= 0; i = bucket.candidates[i].next) {
+            const Candidate &rival = bucket.candidates[i];
+            const int rivalVotes = qPopulationCount(rival.voters);
+            if (i == entry.current || rivalVotes == 0) {
+                continue;
+            }
+            if (winnerVotes > rivalVotes) {
+                losers |= rival.voters;
+            } else {
+                disputed |= winner.voters | rival.voters;
+            }
+        }
+
+        if (disputed) {
+            for (int source = 0; source < m_sources.size(); ++source) {
+                if (disputed & (1u << source)) {
+                    ++m_sources[source].disputed;
+                }
+            }
+            EventLog::instance().record(EventLog::Source::Fusion, EventLog::Code::FusionDisputed,
+                                        {value.slot, value.msgType, bucket.epoch, winnerVotes});
+            emit keyDisputed(value.slot, value.msgType, value.epochSod);
+        }
+
+        for (int source = 0; losers && source < m_sources.size(); ++source) {
+            if (!(losers & (1u << source))) {
+                continue;
+            }
+            losers &= ~(1u << source);
+            ++m_sources[source].inconsistent;
+
+            EventLog::instance().record(EventLog::Source::Fusion, EventLog::Code::FusionInconsistent,
+                                        {source, value.slot, value.msgType, bucket.epoch});
+            emit sourceInconsistent(source, value.slot, value.msgType, value.epochSod);
+        }
+        entry.used = false;
+    }
+    bucket.usedIndexes.resize(0);
+    bucket.candidates.resize(0);
+}
+
+/**
+ * @brief 追加取值实现
+ * @details 取值池扩容会使已有元素地址失效，调用方只持有下标
+ */
+int CorrectionFusion::addCandidate(Bucket &bucket, Entry &entry, const B2bCorrection &value, int source, quint32 voter)
+{
+    Candidate candidate;
+    candidate.value = value;
+    candidate.source = source;
+    candidate.voters = voter;
+    candidate.next = -1;
+
+    const int index = bucket.candidates.size();
+    bucket.candidates.append(candidate);
+    if (entry.firstCandidate < 0) {
+        entry.firstCandidate = index;
+    } else {
+        int last = entry.firstCandidate;
+        while (bucket.candidates[last].next >= 0) {
+            last = bucket.candidates[last].next;
+        }
+        bucket.candidates[last].next = index;
+    }
+    ++entry.candidateCount;
+    return index;
+}
+
+/**
+ * @brief 替换输出实现
+ * @details 得票最多的取值严格多于当前转发值才替换，平票保持当前转发值，避免往复替换
+ */
+void CorrectionFusion::resolve(Bucket &bucket, Entry &entry)
+{
+    int best = entry.current;
+    int bestVotes = qPopulationCount(bucket.candidates[best].voters);
+    for (int i = entry.firstCandidate; i >= 0; i = bucket.candidates[i].next) {
+        const int votes = qPopulationCount(bucket.candidates[i].voters);
+        if (votes > bestVotes) {
+            best = i;
+            bestVotes = votes;
+        }
+    }
+
+    if (best != entry.current) {
+        entry.current = best;
+        emit fused(bucket.candidates[best].value, bucket.candidates[best].source, true);
+    }
+}
+
+/**
+ * @brief 取值一致性判断实现
+ */
+bool CorrectionFusion::sameValue(const B2bCorrection &a, const B2bCorrection &b) const
+{
+    if (a.iodSsr != b.iodSsr || a.iodCorr != b.iodCorr) {
+        return false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        if (std::fabs(a.orbit[i] - b.orbit[i]) > m_tolerance) {
+            return false;
+        }
+    }
+    return std::fabs(a.clockC0 - b.clockC0) <= m_tolerance;
+}
+
+/**
+ * @brief 历元整秒差实现
+ */
+qint64 CorrectionFusion::epochDiff(qint64 a, qint64 b)
+{
+    qint64 diff = (a - b) % 86400;
+    if (diff > 43200) {
+        diff -= 86400;
+    } else if (diff <= -43200) {
+        diff += 86400;
+    }
+    return diff;
+}
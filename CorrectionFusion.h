@@ -0,0 +1,202 @@
+﻿#ifndef CORRECTIONFUSION_H
+#define CORRECTIONFUSION_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+
+#include "Decoder.h"
+
+/**
+ * @class CorrectionFusion
+ * @brief 多数据源改正数融合，将多台接收机（或多颗PPP-B2b GEO卫星）的解码结果合并为单一改正数流
+ * @details 按历元整秒将电文放入定长时间桶环（桶号=历元秒%桶数，无需排序），桶内以卫星号/电文类型为键：
+ *          - 某键在该历元的首条电文立即转发（零附加延迟），任一数据源先到即可补齐其他数据源的缺失；
+ *          - 其余数据源的同历元电文按IOD与数值比对投票，每种不同取值单独计票（最多每个数据源一种），
+ *            某取值得票严格多于已转发值时以替换方式重新转发；
+ *          - 同一数据源在同一历元对同一键给出不同取值时撤回其全部投票，记为不一致并单独上报；
+ *          - 早于该键已转发历元且已移出时间窗的电文视为过期丢弃；
+ *          - 时间桶回收时，对每种落败取值分别比较：已转发值得票严格多于该取值时，将其数据源记为不一致；
+ *            与已转发值平票（如两个数据源各执一值）无法判定对错，记为争议键上报，不归咎任何数据源。
+ *          电文通过submit直接调用输入，fused信号同步输出，需在同一线程中使用
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class CorrectionFusion : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @struct SourceStats
+     * @brief 单个数据源统计
+     */
+    struct SourceStats {
+        quint64 received = 0;      // 收到电文数
+        quint64 forwarded = 0;     // 首先到达并被转发的电文数（含补齐其他数据源缺失）
+        quint64 duplicates = 0;    // 与已转发值一致的重复电文数
+        quint64 stale = 0;         // 过期丢弃的电文数
+        quint64 inconsistent = 0;  // 与严格多数不一致或同历元自相矛盾的电文数
+        quint64 disputed = 0;      // 参与平票（无法判定）的电文数
+    };
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit CorrectionFusion(QObject *parent = nullptr);
+
+    /**
+     * @brief 注册数据源
+     * @return int 数据源序号（0起，最多32个），超出返回-1
+     */
+    int addSource();
+
+    /**
+     * @brief 数据源数量
+     * @return int 已注册的数据源数
+     */
+    int sourceCount() const { return m_sources.size(); }
+
+    /**
+     * @brief 获取数据源统计
+     * @param source 数据源序号
+     * @return const SourceStats& 统计信息
+     */
+    const SourceStats &sourceStats(int source) const { return m_sources[source]; }
+
+    /**
+     * @brief 设置数值一致性容差
+     * @param meters 轨道/钟差改正数允许的差值（m，默认0.001）
+     */
+    void setTolerance(double meters) { m_tolerance = meters; }
+
+public slots:
+    /**
+     * @brief 输入一条解码后的电文
+     * @param source 数据源序号
+     * @param correction 电文（内容被复制，可来自历元内存池）
+     */
+    void submit(int source, const B2bCorrection &correction);
+
+    /**
+     * @brief 回收全部时间桶
+     * @details 结束时调用，完成剩余历元的不一致判定
+     */
+    void flush();
+
+signals:
+    /**
+     * @brief 融合输出信号
+     * @param correction 融合后的电文（next为nullptr）
+     * @param source 提供该值的数据源序号
+     * @param replacement true=多数票推翻先前转发值后的替换输出
+     */
+    void fused(const B2bCorrection &correction, int source, bool replacement);
+
+    /**
+     * @brief 数据源不一致信号
+     * @param source 数据源序号
+     * @param slot 卫星号
+     * @param msgType 电文类型
+     * @param epochSod 历元时刻（BDT天内秒）
+     */
+    void sourceInconsistent(int source, int slot, int msgType, double epochSod);
+
+    /**
+     * @brief 争议键信号
+     * @param slot 卫星号
+     * @param msgType 电文类型
+     * @param epochSod 历元时刻（BDT天内秒）
+     * @details 各取值得票相同、无严格多数，当前输出保持为先到取值
+     */
+    void keyDisputed(int slot, int msgType, double epochSod);
+
+private:
+    /**
+     * @struct Candidate
+     * @brief 同一键同一历元的一种取值及其投票数据源
+     */
+    struct Candidate {
+        B2bCorrection value;   // 取值
+        int source = -1;       // 首个给出该取值的数据源
+        quint32 voters = 0;    // 投票数据源位图
+        int next = -1;         // 同一键的下一种取值（时间桶取值池下标，-1为无）
+    };
+
+    /**
+     * @struct Entry
+     * @brief 时间桶内单个键（卫星号/电文类型）的投票状态
+     */
+    struct Entry {
+        quint32 key = 0;           // 键值
+        bool used = false;         // 是否占用
+        int candidateCount = 0;    // 取值数（0~数据源数）
+        int firstCandidate = -1;   // 首种取值（时间桶取值池下标）
+        int current = -1;          // 当前转发值（时间桶取值池下标）
+        quint32 seen = 0;          // 已投票数据源位图
+        quint32 conflicted = 0;    // 同历元给出不同取值的数据源位图（投票已撤回）
+    };
+
+    /**
+     * @struct Bucket
+     * @brief 单个历元整秒的时间桶
+     * @details 键表为定长开放寻址表，回收时只清理已占用的位置；
+     *          各键的取值存放在桶内取值池中，按键以next串联，回收时整体清空（保留容量）
+     */
+    struct Bucket {
+        qint64 epoch = -1;         // 历元整秒（BDT天内秒，-1为空）
+        QVector<Entry> table;      // 开放寻址键表
+        QVector<int> usedIndexes;  // 已占用位置
+        QVector<Candidate> candidates; // 取值池
+    };
+
+    /**
+     * @brief 在时间桶中查找或创建键
+     * @return Entry* 键状态，表满返回nullptr
+     */
+    Entry *findEntry(Bucket &bucket, quint32 key);
+
+    /**
+     * @brief 回收时间桶，判定不一致数据源与争议键
+     */
+    void retireBucket(Bucket &bucket);
+
+    /**
+     * @brief 为键追加一种取值
+     * @return int 取值池下标
+     */
+    int addCandidate(Bucket &bucket, Entry &entry, const B2bCorrection &value, int source, quint32 voter);
+
+    /**
+     * @brief 得票最多的取值严格多于当前转发值时替换输出
+     */
+    void resolve(Bucket &bucket, Entry &entry);
+
+    /**
+     * @brief 判断两条电文取值是否一致
+     */
+    bool sameValue(const B2bCorrection &a, const B2bCorrection &b) const;
+
+    /**
+     * @brief 历元整秒差（处理跨天）
+     * @return qint64 a-b，范围(-43200, 43200]
+     */
+    static qint64 epochDiff(qint64 a, qint64 b);
+
+    /**
+     * @brief 生成键值
+     */
+    static quint32 entryKey(int slot, int msgType) { return (static_cast<quint32>(slot) << 8) | static_cast<quint32>(msgType & 0xFF); }
+
+    static const int kBucketCount = 16;   // 时间桶数（时间窗秒数）
+    static const int kTableSize = 1024;   // 单桶键表容量（2的幂）
+    static const int kPoolReserve = 2048; // 单桶取值池预留容量（平均每键两种取值）
+    static const int kMaxSources = 32;    // 最大数据源数（投票位图宽度）
+
+    QVector<Bucket> m_buckets;            // 时间桶环
+    QVector<SourceStats> m_sources;       // 数据源统计
+    QHash<quint32, qint64> m_latestEpoch; // 各键已转发的最新历元整秒
+    double m_tolerance = 0.001;           // 数值一致性容差（m）
+};
+
+#endif // CORRECTIONFUSION_H
@@ -0,0 +1,199 @@
+﻿#include "CorrectionMonitor.h"
+#include "utils.h"
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
+
+// CSV表头：intervalMs为历元更新间隔，gapMs为两次到达间隔（含重复播发）
+static const char *const kCsvHeader = "sat,slot,msgType,rxUtc,ageMs,intervalMs,gapMs,latencyUs\n";
+
+/**
+ * @brief 构造函数实现
+ * @param capacity 环形缓冲区容量
+ * @param parent 父对象
+ */
+CorrectionMonitor::CorrectionMonitor(int capacity, QObject *parent)
+    : QObject(parent)
+    , m_capacity(qMax(capacity, 2))
+{
+}
+
+/**
+ * @brief 登记改正数电文实现
+ * @param slot 卫星号
+ * @param msgType 电文类型
+ * @param epochSod 电文历元时刻（BDT天内秒）
+ * @param rxTimeNs 字节到达时刻
+ */
+void CorrectionMonitor::recordCorrection(int slot, int msgType, double epochSod, qint64 rxTimeNs)
+{
+    // 以字节到达时刻计算龄期与间隔，不含解码与投递耗时
+    const qint64 rxUtcMs = Utils::steadyNsToUtcMs(rxTimeNs);
+    const qint64 latencyNs = Utils::steadyNowNs() - rxTimeNs;
+
+    // 查找或创建跟踪项（环形缓冲区一次性分配）
+    const quint32 key = trackKey(slot, msgType);
+    int index = m_index.value(key, -1);
+    const bool isNew = index < 0;
+    if (isNew) {
+        Track track;
+        track.slot = slot;
+        track.msgType = msgType;
+        track.ring.resize(m_capacity);
+        index = m_tracks.size();
+        m_tracks.append(track);
+        m_index.insert(key, index);
+    }
+    Track &track = m_tracks[index];
+
+    // 龄期 = 到达时刻BDT天内秒 - 历元时刻，处理跨天
+    double ageSec = Utils::utcMsToBdtSod(rxUtcMs) - epochSod;
+    if (ageSec < -43200.0) {
+        ageSec += 86400.0;
+    } else if (ageSec > 43200.0) {
+        ageSec -= 86400.0;
+    }
+
+    Sample sample;
+    sample.rxUtcMs = rxUtcMs;
+    sample.ageMs = static_cast<qint32>(ageSec * 1000.0);
+    sample.gapMs = track.count > 0 ? static_cast<qint32>(rxUtcMs - track.latest().rxUtcMs) : -1;
+
+    // 历元变化才是一次更新，同一历元的重复播发不计入更新间隔
+    if (epochSod != track.epochSod) {
+        if (track.epochSod >= 0.0) {
+            sample.intervalMs = static_cast<qint32>(rxUtcMs - track.epochRxUtcMs);
+        }
+        track.epochSod = epochSod;
+        track.epochRxUtcMs = rxUtcMs;
+    }
+    sample.latencyUs = static_cast<qint32>(latencyNs / 1000);
+
+    // 写入环形缓冲区，满后覆盖最早样本
+    track.ring[track.head] = sample;
+    track.head = (track.head + 1) % track.ring.size();
+    if (track.count < track.ring.size()) {
+        ++track.count;
+    }
+    ++track.total;
+
+    if (isNew) {
+        emit trackAdded(index);
+    }
+}
+
+/**
+ * @brief 清空全部跟踪项实现
+ */
+void CorrectionMonitor::clear()
+{
+    m_tracks.clear();
+    m_index.clear();
+    emit cleared();
+}
+
+/**
+ * @brief 计算指定时刻龄期实现
+ * @param index 跟踪项序号
+ * @param utcMs 指定时刻
+ * @return 龄期（ms）
+ */
+qint64 CorrectionMonitor::ageAt(int index, qint64 utcMs) const
+{
+    const Track &track = m_tracks[index];
+
+    // 从最新样本向前查找该时刻之前的最近一次接收
+    for (int i = track.count - 1; i >= 0; --i) {
+        const Sample &sample = track.sample(i);
+        if (sample.rxUtcMs <= utcMs) {
+            return sample.ageMs + (utcMs - sample.rxUtcMs);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 导出CSV实现
+ * @param path 文件路径
+ * @return 导出结果
+ */
+bool CorrectionMonitor::exportCsv(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << kCsvHeader;
+    for (const Track &track : m_tracks) {
+        const QString name = slotName(track.slot);
+        for (int i = 0; i < track.count; ++i) {
+            writeCsvRow(out, name, track, track.sample(i));
+        }
+    }
+
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+/**
+ * @brief 增量导出CSV实现
+ * @param path 文件路径
+ * @return 导出结果
+ */
+bool CorrectionMonitor::appendCsv(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    if (file.size() == 0) {
+        out << kCsvHeader;
+    }
+    for (Track &track : m_tracks) {
+        const int fresh = static_cast<int>(qMin<quint64>(track.total - track.exported, static_cast<quint64>(track.count)));
+        if (fresh == 0) {
+            continue;
+        }
+        const QString name = slotName(track.slot);
+        for (int i = track.count - fresh; i < track.count; ++i) {
+            writeCsvRow(out, name, track, track.sample(i));
+        }
+        track.exported = track.total;
+    }
+
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+/**
+ * @brief 写入一行CSV样本实现
+ */
+void CorrectionMonitor::writeCsvRow(QTextStream &out, const QString &name, const Track &track, const Sample &sample)
+{
+    out << name << ',' << track.slot << ',' << track.msgType << ','
+        << QDateTime::fromMSecsSinceEpoch(sample.rxUtcMs, Qt::UTC).toString(Qt::ISODateWithMs) << ','
+        << sample.ageMs << ',' << sample.intervalMs << ',' << sample.gapMs << ',' << sample.latencyUs << '\n';
+}
+
+/**
+ * @brief 卫星号转换为卫星名实现
+ * @param slot 卫星号
+ * @return 卫星名
+ */
+QString CorrectionMonitor::slotName(int slot)
+{
+    if (slot >= 1 && slot <= 63) {
+        return QString("C%1").arg(slot, 2, 10, QChar('0'));
+    } else if (slot >= 64 && slot <= 100) {
+        return QString("G%1").arg(slot - 63, 2, 10, QChar('0'));
+    } else if (slot >= 101 && slot <= 137) {
+        return QString("E%1").arg(slot - 100, 2, 10, QChar('0'));
+    } else if (slot >= 138 && slot <= 174) {
+        return QString("R%1").arg(slot - 137, 2, 10, QChar('0'));
+    }
+    return QString("#%1").arg(slot);
+}
@@ -0,0 +1,164 @@
+﻿#ifndef CORRECTIONMONITOR_H
+#define CORRECTIONMONITOR_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QString>
+
+class QTextStream;
+
+/**
+ * @class CorrectionMonitor
+ * @brief 改正数时效监视器，按卫星和电文类型跟踪PPP-B2b改正数的龄期、更新间隔与投递延迟
+ * @details 每条解码后的改正数电文通过recordCorrection登记，监视器记录：
+ *          - 龄期：字节到达时刻（由rxTimeNs换算为BDT天内秒）与电文历元时刻之差，任意时刻的龄期可由最近一次接收外推；
+ *          - 更新间隔：电文历元变化时，新历元与上一历元首次到达之间的时间（B2b对同一历元重复播发，
+ *            重复播发不计为更新）；两次到达之间的间隔另行记录，反映重复播发周期；
+ *          - 投递延迟：字节到达（rxTimeNs）至监视器登记之间的时间。
+ *          每个跟踪项使用定长环形缓冲区保存历史样本，长期运行内存不增长
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class CorrectionMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @struct Sample
+     * @brief 一次接收的时效样本
+     */
+    struct Sample {
+        qint64 rxUtcMs = 0;     // 字节到达时刻（UTC毫秒）
+        qint32 ageMs = 0;       // 字节到达时刻的龄期（ms）
+        qint32 intervalMs = -1; // 更新间隔：与上一历元首次到达的间隔（ms，历元未变化或首次接收为-1）
+        qint32 gapMs = -1;      // 与上次到达的间隔（ms，含同一历元的重复播发，首次接收为-1）
+        qint32 latencyUs = 0;   // 字节到达至登记的投递延迟（us）
+    };
+
+    /**
+     * @struct Track
+     * @brief 单颗卫星单个电文类型的跟踪项
+     * @details 样本保存在定长环形缓冲区中，按时间顺序通过sample(i)访问
+     */
+    struct Track {
+        int slot = 0;           // PPP-B2b卫星号（1~255）
+        int msgType = 0;        // 电文类型（1~7）
+        QVector<Sample> ring;   // 环形缓冲区（容量固定）
+        int head = 0;           // 下一个写入位置
+        int count = 0;          // 有效样本数
+        quint64 total = 0;      // 累计写入样本数
+        quint64 exported = 0;   // 已增量导出的样本数（累计写入计数）
+        double epochSod = -1.0; // 当前电文历元（BDT天内秒，-1为无）
+        qint64 epochRxUtcMs = 0;// 当前电文历元首次到达时刻（UTC毫秒）
+
+        /**
+         * @brief 按时间顺序获取样本
+         * @param i 序号（0为最早，count-1为最新）
+         * @return const Sample& 样本
+         */
+        const Sample &sample(int i) const { return ring[(head - count + i + ring.size()) % ring.size()]; }
+
+        /**
+         * @brief 获取最新样本
+         * @return const Sample& 最新样本（count必须大于0）
+         */
+        const Sample &latest() const { return sample(count - 1); }
+    };
+
+    /**
+     * @brief 构造函数
+     * @param capacity 每个跟踪项保存的样本数（环形缓冲区容量）
+     * @param parent 父对象
+     */
+    explicit CorrectionMonitor(int capacity = 4096, QObject *parent = nullptr);
+
+    /**
+     * @brief 跟踪项数量
+     * @return int 已出现过的卫星/电文类型组合数
+     */
+    int trackCount() const { return m_tracks.size(); }
+
+    /**
+     * @brief 按序号获取跟踪项
+     * @param index 序号（按首次出现顺序）
+     * @return const Track& 跟踪项
+     */
+    const Track &track(int index) const { return m_tracks[index]; }
+
+    /**
+     * @brief 计算跟踪项在指定时刻的龄期
+     * @param index 跟踪项序号
+     * @param utcMs 指定时刻（UTC毫秒）
+     * @return qint64 龄期（ms），该时刻之前无接收返回-1
+     */
+    qint64 ageAt(int index, qint64 utcMs) const;
+
+    /**
+     * @brief 导出全部样本为CSV
+     * @param path 文件路径
+     * @return bool 导出成功返回true，失败返回false
+     */
+    bool exportCsv(const QString &path) const;
+
+    /**
+     * @brief 增量导出CSV
+     * @param path 文件路径（追加写入，文件为空时先写表头）
+     * @return bool 导出成功返回true，失败返回false
+     * @details 只追加上次增量导出之后的新样本，适用于长期运行中的周期导出；
+     *          两次导出之间环形缓冲区被覆盖的样本不再导出
+     */
+    bool appendCsv(const QString &path);
+
+    /**
+     * @brief PPP-B2b卫星号转换为卫星名
+     * @param slot 卫星号（1~63 BDS，64~100 GPS，101~137 Galileo，138~174 GLONASS）
+     * @return QString 卫星名（如"C19"），无效卫星号返回"#slot"
+     */
+    static QString slotName(int slot);
+
+public slots:
+    /**
+     * @brief 登记一条改正数电文
+     * @param slot PPP-B2b卫星号
+     * @param msgType 电文类型
+     * @param epochSod 电文历元时刻（BDT天内秒）
+     * @param rxTimeNs 电文字节到达时刻（Utils::steadyNowNs）
+     * @details 由解码层在每条改正数电文解出后调用
+     */
+    void recordCorrection(int slot, int msgType, double epochSod, qint64 rxTimeNs);
+
+    /**
+     * @brief 清空全部跟踪项
+     */
+    void clear();
+
+signals:
+    /**
+     * @brief 新跟踪项信号
+     * @param index 新跟踪项序号
+     */
+    void trackAdded(int index);
+
+    /**
+     * @brief 清空信号
+     */
+    void cleared();
+
+private:
+    /**
+     * @brief 生成跟踪项键值
+     */
+    static quint32 trackKey(int slot, int msgType) { return (static_cast<quint32>(slot) << 8) | static_cast<quint32>(msgType & 0xFF); }
+
+    /**
+     * @brief 写入一行CSV样本
+     */
+    static void writeCsvRow(QTextStream &out, const QString &name, const Track &track, const Sample &sample);
+
+    int m_capacity;                 // 每个跟踪项的环形缓冲区容量
+    QVector<Track> m_tracks;        // 跟踪项（按首次出现顺序）
+    QHash<quint32, int> m_index;    // 键值 -> 跟踪项序号
+};
+
+#endif // CORRECTIONMONITOR_H
@@ -0,0 +1,237 @@
+﻿#include "CorrectionTimelineWidget.h"
+#include "CorrectionMonitor.h"
+#include <QDateTime>
+#include <QPainter>
+
+/**
+ * @brief 构造函数实现
+ * @param parent 父控件
+ */
+CorrectionTimelineWidget::CorrectionTimelineWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    // 画布自行管理背景，避免系统重复擦除
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    m_tickTimer = new QTimer(this);
+    m_tickTimer->setInterval(kTickMs);
+    connect(m_tickTimer, &QTimer::timeout, this, &CorrectionTimelineWidget::onTickTimeout);
+}
+
+/**
+ * @brief 绑定监视器实现
+ * @param monitor 监视器
+ */
+void CorrectionTimelineWidget::setMonitor(CorrectionMonitor *monitor)
+{
+    if (m_monitor) {
+        m_monitor->disconnect(this);
+    }
+
+    m_monitor = monitor;
+    if (m_monitor) {
+        connect(m_monitor, &CorrectionMonitor::trackAdded, this, &CorrectionTimelineWidget::onTrackAdded);
+        connect(m_monitor, &CorrectionMonitor::cleared, this, &CorrectionTimelineWidget::onMonitorCleared);
+        m_tickTimer->start();
+    } else {
+        m_tickTimer->stop();
+    }
+
+    updateRowsHeight();
+    rebuildCanvas();
+}
+
+/**
+ * @brief 建议尺寸实现
+ * @details 高度为全部跟踪项行高之和
+ */
+QSize CorrectionTimelineWidget::sizeHint() const
+{
+    const int rows = m_monitor ? m_monitor->trackCount() : 0;
+    return QSize(kLabelWidth + 240, qMax(rows, 1) * kRowHeight);
+}
+
+/**
+ * @brief 绘制事件实现
+ * @details 仅绘制标签区并贴上离屏画布
+ */
+void CorrectionTimelineWidget::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    painter.fillRect(0, 0, kLabelWidth, height(), palette().window());
+
+    if (!m_canvas.isNull()) {
+        painter.drawPixmap(kLabelWidth, 0, m_canvas);
+    }
+
+    // 改正数解码尚未接入通讯数据通路，无样本时提示而不是显示空白面板
+    if (!m_monitor || m_monitor->trackCount() == 0) {
+        painter.setPen(palette().windowText().color());
+        painter.drawText(rect(), Qt::AlignCenter, "暂无改正数电文（解码模块接入后显示）");
+        return;
+    }
+
+    // 绘制卫星/电文类型标签，仅绘制滚动区域中可见的行
+    QFont font = painter.font();
+    font.setPixelSize(kRowHeight - 2);
+    painter.setFont(font);
+    painter.setPen(palette().windowText().color());
+    const int firstRow = qMax(event->rect().top() / kRowHeight, 0);
+    const int lastRow = qMin(event->rect().bottom() / kRowHeight, m_monitor->trackCount() - 1);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const CorrectionMonitor::Track &track = m_monitor->track(row);
+        painter.drawText(QRect(2, row * kRowHeight, kLabelWidth - 4, kRowHeight),
+                         Qt::AlignVCenter | Qt::AlignLeft,
+                         QString("%1-%2").arg(CorrectionMonitor::slotName(track.slot)).arg(track.msgType));
+    }
+}
+
+/**
+ * @brief 尺寸变化事件实现
+ */
+void CorrectionTimelineWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    rebuildCanvas();
+}
+
+// ========== 槽函数实现 ==========
+
+/**
+ * @brief 定时推进槽函数实现
+ */
+void CorrectionTimelineWidget::onTickTimeout()
+{
+    if (m_canvas.isNull() || !m_monitor) {
+        return;
+    }
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const int columns = static_cast<int>((nowMs - m_lastTickMs) / kTickMs);
+    if (columns <= 0) {
+        return;
+    }
+    if (columns >= m_canvas.width()) {
+        rebuildCanvas();
+        update();
+        return;
+    }
+
+    // 画布左移，仅绘制新露出的列
+    const int width = m_canvas.width();
+    m_canvas.scroll(-columns, 0, m_canvas.rect());
+
+    QPainter painter(&m_canvas);
+    painter.fillRect(width - columns, 0, columns, m_canvas.height(), palette().base());
+    for (int k = 1; k <= columns; ++k) {
+        const qint64 t = m_lastTickMs + static_cast<qint64>(k) * kTickMs;
+        const int x = width - columns - 1 + k;
+        for (int row = 0; row < m_monitor->trackCount(); ++row) {
+            painter.fillRect(x, row * kRowHeight, 1, kRowHeight - 1, ageColor(m_monitor->ageAt(row, t)));
+        }
+    }
+    m_lastTickMs += static_cast<qint64>(columns) * kTickMs;
+
+    update();
+}
+
+/**
+ * @brief 新跟踪项槽函数实现
+ * @param index 跟踪项序号
+ */
+void CorrectionTimelineWidget::onTrackAdded(int index)
+{
+    Q_UNUSED(index)
+
+    // 画布高度足够时新行直接从下一列开始绘制；不足时由滚动区域调整控件高度，经resizeEvent重建
+    updateRowsHeight();
+    update();
+}
+
+/**
+ * @brief 监视器清空槽函数实现
+ */
+void CorrectionTimelineWidget::onMonitorCleared()
+{
+    updateRowsHeight();
+    rebuildCanvas();
+    update();
+}
+
+// ========== 私有函数实现 ==========
+
+/**
+ * @brief 重建画布实现
+ * @details 按列回放每个跟踪项环形缓冲区中的样本，同色连续区段合并绘制
+ */
+void CorrectionTimelineWidget::rebuildCanvas()
+{
+    const int width = this->width() - kLabelWidth;
+    if (width <= 0 || height() <= 0) {
+        m_canvas = QPixmap();
+        return;
+    }
+
+    m_canvas = QPixmap(width, height());
+    m_canvas.fill(palette().base().color());
+    m_lastTickMs = QDateTime::currentMSecsSinceEpoch();
+
+    if (!m_monitor) {
+        return;
+    }
+
+    const int rows = m_monitor->trackCount();
+
+    QPainter painter(&m_canvas);
+    for (int row = 0; row < rows; ++row) {
+        const CorrectionMonitor::Track &track = m_monitor->track(row);
+        int i = 0;
+        int spanStart = 0;
+        QColor spanColor;
+        for (int x = 0; x < width; ++x) {
+            const qint64 t = m_lastTickMs - static_cast<qint64>(width - 1 - x) * kTickMs;
+            while (i < track.count && track.sample(i).rxUtcMs <= t) {
+                ++i;
+            }
+            const qint64 ageMs = i > 0 ? track.sample(i - 1).ageMs + (t - track.sample(i - 1).rxUtcMs) : -1;
+            const QColor color = ageColor(ageMs);
+            if (x == 0) {
+                spanColor = color;
+            } else if (color != spanColor) {
+                painter.fillRect(spanStart, row * kRowHeight, x - spanStart, kRowHeight - 1, spanColor);
+                spanStart = x;
+                spanColor = color;
+            }
+        }
+        painter.fillRect(spanStart, row * kRowHeight, width - spanStart, kRowHeight - 1, spanColor);
+    }
+}
+
+/**
+ * @brief 更新控件最小高度实现
+ */
+void CorrectionTimelineWidget::updateRowsHeight()
+{
+    const int rows = m_monitor ? m_monitor->trackCount() : 0;
+    setMinimumHeight(qMax(rows, 1) * kRowHeight);
+    updateGeometry();
+}
+
+/**
+ * @brief 龄期映射颜色实现
+ * @param ageMs 龄期
+ * @return 颜色
+ */
+QColor CorrectionTimelineWidget::ageColor(qint64 ageMs)
+{
+    if (ageMs < 0) {
+        return QColor(220, 220, 220);   // 无数据
+    } else if (ageMs <= 12000) {
+        return QColor(46, 160, 67);     // 新鲜
+    } else if (ageMs <= 48000) {
+        return QColor(140, 200, 60);    // 正常更新周期内
+    } else if (ageMs <= 96000) {
+        return QColor(230, 190, 40);    // 接近有效期
+    }
+    return QColor(210, 60, 50);         // 过期
+}
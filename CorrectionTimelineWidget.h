@@ -0,0 +1,88 @@
+﻿#ifndef CORRECTIONTIMELINEWIDGET_H
+#define CORRECTIONTIMELINEWIDGET_H
+
+#include <QWidget>
+#include <QPixmap>
+#include <QTimer>
+
+class CorrectionMonitor;
+
+/**
+ * @class CorrectionTimelineWidget
+ * @brief 改正数龄期时间线控件，每行对应一颗卫星的一个电文类型，横轴为时间，颜色表示龄期
+ * @details 时间线绘制在离屏画布上，每秒仅将画布左移一列并绘制最右侧新列（增量绘制），
+ *          paintEvent只负责贴图；仅在尺寸变化时由监视器的环形缓冲区重建整幅画布。
+ *          行高固定（保证每行都能显示标签），控件高度随跟踪项数增长，需放在QScrollArea中纵向滚动
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class CorrectionTimelineWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父控件
+     */
+    explicit CorrectionTimelineWidget(QWidget *parent = nullptr);
+
+    /**
+     * @brief 绑定改正数时效监视器
+     * @param monitor 监视器（不转移所有权）
+     */
+    void setMonitor(CorrectionMonitor *monitor);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    /**
+     * @brief 定时推进槽函数
+     * @details 画布左移一列并绘制最新一列
+     */
+    void onTickTimeout();
+
+    /**
+     * @brief 新跟踪项槽函数
+     * @param index 跟踪项序号
+     */
+    void onTrackAdded(int index);
+
+    /**
+     * @brief 监视器清空槽函数
+     */
+    void onMonitorCleared();
+
+private:
+    /**
+     * @brief 由监视器历史样本重建整幅画布
+     */
+    void rebuildCanvas();
+
+    /**
+     * @brief 按跟踪项数更新控件最小高度
+     * @details 所在QScrollArea据此调整控件高度，高度变化时经resizeEvent重建画布
+     */
+    void updateRowsHeight();
+
+    /**
+     * @brief 龄期映射为颜色
+     * @param ageMs 龄期（ms，-1表示无数据）
+     * @return QColor 颜色
+     */
+    static QColor ageColor(qint64 ageMs);
+
+    CorrectionMonitor *m_monitor = nullptr; // 改正数时效监视器
+    QTimer *m_tickTimer;                    // 推进定时器（每列1秒）
+    QPixmap m_canvas;                       // 离屏时间线画布（不含左侧标签区）
+    qint64 m_lastTickMs = 0;                // 画布最右列对应的UTC毫秒
+
+    static const int kLabelWidth = 56;      // 左侧标签区宽度
+    static const int kRowHeight = 12;       // 行高（像素，足以显示标签）
+    static const int kTickMs = 1000;        // 每列对应的时间（ms）
+};
+
+#endif // CORRECTIONTIMELINEWIDGET_H
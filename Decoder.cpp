@@ -0,0 +1,48 @@
+﻿#include "Decoder.h"
+
+/**
+ * @brief 构造函数实现
+ * @param arenaBlockSize 内存块大小
+ */
+Decoder::Decoder(std::size_t arenaBlockSize)
+    : m_arena(arenaBlockSize)
+{
+}
+
+/**
+ * @brief 开始新历元实现
+ * @param epochSod 历元时刻
+ * @return 当前历元
+ */
+CorrectionEpoch *Decoder::beginEpoch(double epochSod)
+{
+    if (m_epoch && m_epoch->epochSod == epochSod) {
+        return m_epoch;
+    }
+
+    // 历元切换：整体回收上一历元的对象
+    m_arena.reset();
+    m_epoch = m_arena.create<CorrectionEpoch>();
+    m_epoch->epochSod = epochSod;
+    return m_epoch;
+}
+
+/**
+ * @brief 创建电文实现
+ * @param slot 卫星号
+ * @param msgType 电文类型
+ * @return 电文
+ */
+B2bCorrection *Decoder::newCorrection(int slot, int msgType)
+{
+    if (!m_epoch) {
+        return nullptr;
+    }
+
+    B2bCorrection *correction = m_arena.create<B2bCorrection>();
+    correction->slot = slot;
+    correction->msgType = msgType;
+    correction->epochSod = m_epoch->epochSod;
+    m_epoch->append(correction);
+    return correction;
+}
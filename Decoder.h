@@ -1,4 +1,103 @@
-#ifndef DECODER_H
+﻿#ifndef DECODER_H
 #define DECODER_H
 
+#include <QtGlobal>
+
+#include "EpochArena.h"
+
+/**
+ * @struct B2bCorrection
+ * @brief 单条PPP-B2b改正数电文解码结果
+ * @details 平凡析构类型，由Decoder在历元内存池中创建，历元切换后失效
+ */
+struct B2bCorrection {
+    int slot = 0;                   // PPP-B2b卫星号（1~255）
+    int msgType = 0;                // 电文类型（1~7）
+    double epochSod = 0.0;          // 电文历元时刻（BDT天内秒）
+    int iodSsr = 0;                 // IOD SSR
+    int iodCorr = 0;                // IOD Corr（轨道/钟差改正数版本号）
+    double orbit[3] = {0.0, 0.0, 0.0}; // 轨道改正数：径向/切向/法向（m）
+    double clockC0 = 0.0;           // 钟差改正数C0（m）
+    qint64 rxTimeNs = 0;            // 电文字节到达时刻（Utils::steadyNowNs）
+    B2bCorrection *next = nullptr;  // 同历元下一条电文
+};
+
+/**
+ * @struct CorrectionEpoch
+ * @brief 单个历元的状态更新集合
+ * @details 以链表串联本历元解出的全部改正数，与电文一同分配在历元内存池中
+ */
+struct CorrectionEpoch {
+    double epochSod = 0.0;           // 历元时刻（BDT天内秒）
+    int count = 0;                   // 电文条数
+    B2bCorrection *head = nullptr;   // 首条电文
+    B2bCorrection *tail = nullptr;   // 末条电文
+
+    /**
+     * @brief 追加一条电文
+     * @param correction 电文（需分配在同一历元内存池中）
+     */
+    void append(B2bCorrection *correction)
+    {
+        correction->next = nullptr;
+        if (tail) {
+            tail->next = correction;
+        } else {
+            head = correction;
+        }
+        tail = correction;
+        ++count;
+    }
+};
+
+/**
+ * @class Decoder
+ * @brief 解码层对象管理，负责按历元分配电文及状态更新对象
+ * @details 每个历元的全部解码对象分配在同一个EpochArena中，历元切换时整体复位，
+ *          长期运行时不产生逐条电文的堆分配与释放
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class Decoder
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param arenaBlockSize 历元内存池内存块大小（字节）
+     */
+    explicit Decoder(std::size_t arenaBlockSize = 64 * 1024);
+
+    /**
+     * @brief 开始新历元
+     * @param epochSod 历元时刻（BDT天内秒）
+     * @return CorrectionEpoch* 当前历元；历元未变化时返回原历元，变化时复位内存池并创建新历元
+     * @details 历元切换后，上一历元的全部对象失效，使用方需在此之前处理完毕
+     */
+    CorrectionEpoch *beginEpoch(double epochSod);
+
+    /**
+     * @brief 在当前历元中创建一条电文
+     * @param slot 卫星号
+     * @param msgType 电文类型
+     * @return B2bCorrection* 电文（已追加到当前历元），未开始历元返回nullptr
+     */
+    B2bCorrection *newCorrection(int slot, int msgType);
+
+    /**
+     * @brief 获取当前历元
+     * @return CorrectionEpoch* 当前历元，未开始返回nullptr
+     */
+    CorrectionEpoch *currentEpoch() const { return m_epoch; }
+
+    /**
+     * @brief 获取历元内存池统计
+     * @return const EpochArena::Stats& 统计信息
+     */
+    const EpochArena::Stats &arenaStats() const { return m_arena.stats(); }
+
+private:
+    EpochArena m_arena;                 // 历元内存池
+    CorrectionEpoch *m_epoch = nullptr; // 当前历元（分配在m_arena中）
+};
+
 #endif // DECODER_H
@@ -0,0 +1,73 @@
+﻿#include "EpochArena.h"
+
+/**
+ * @brief 构造函数实现
+ * @param blockSize 内存块大小
+ */
+EpochArena::EpochArena(std::size_t blockSize)
+    : m_blockSize(qMax<std::size_t>(blockSize, 256))
+{
+}
+
+/**
+ * @brief 析构函数实现
+ */
+EpochArena::~EpochArena()
+{
+    for (const Block &block : m_blocks) {
+        ::operator delete(block.data);
+    }
+}
+
+/**
+ * @brief 分配内存实现
+ * @param size 字节数
+ * @param align 对齐字节数
+ * @return 内存地址
+ */
+void *EpochArena::allocate(std::size_t size, std::size_t align)
+{
+    ++m_stats.allocations;
+
+    for (;;) {
+        // 在当前内存块中按地址对齐尝试分配
+        if (m_current < m_blocks.size()) {
+            const Block &block = m_blocks.at(m_current);
+            const quintptr address = reinterpret_cast<quintptr>(block.data) + m_offset;
+            const std::size_t padding = (align - address % align) % align;
+            if (m_offset + padding + size <= block.size) {
+                char *result = block.data + m_offset + padding;
+                m_offset += padding + size;
+                m_stats.bytesInUse += padding + size;
+                m_stats.highWater = qMax(m_stats.highWater, m_stats.bytesInUse);
+                return result;
+            }
+
+            // 当前块不足，顺延到下一个已有内存块
+            ++m_current;
+            m_offset = 0;
+            continue;
+        }
+
+        // 已有内存块均不足，申请新块（超大请求单独成块），之后的历元复用
+        Block block;
+        block.size = qMax(m_blockSize, size + align);
+        block.data = static_cast<char *>(::operator new(block.size));
+        m_blocks.append(block);
+        m_current = m_blocks.size() - 1;
+        m_offset = 0;
+        ++m_stats.blockAllocations;
+        m_stats.capacity += block.size;
+    }
+}
+
+/**
+ * @brief 复位内存池实现
+ */
+void EpochArena::reset()
+{
+    m_current = 0;
+    m_offset = 0;
+    m_stats.bytesInUse = 0;
+    ++m_stats.resets;
+}
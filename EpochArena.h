@@ -0,0 +1,98 @@
+﻿#ifndef EPOCHARENA_H
+#define EPOCHARENA_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class EpochArena
+ * @brief 按历元复位的单调内存池，用于每个历元内解码电文及状态更新对象的分配
+ * @details 分配只移动指针，不单独释放；历元切换时调用reset整体回收，已申请的内存块保留复用，
+ *          稳定运行后不再向系统申请内存。仅允许创建平凡析构类型（reset时不调用析构函数）
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class EpochArena
+{
+public:
+    /**
+     * @struct Stats
+     * @brief 内存池统计
+     */
+    struct Stats {
+        quint64 allocations = 0;       // 累计分配次数
+        quint64 resets = 0;            // 累计复位次数
+        quint64 blockAllocations = 0;  // 累计向系统申请内存块次数
+        std::size_t bytesInUse = 0;    // 当前历元已用字节数
+        std::size_t highWater = 0;     // 单历元最大用量（字节）
+        std::size_t capacity = 0;      // 已申请内存块总容量（字节）
+    };
+
+    /**
+     * @brief 构造函数
+     * @param blockSize 单个内存块大小（字节）
+     */
+    explicit EpochArena(std::size_t blockSize = 64 * 1024);
+
+    /**
+     * @brief 析构函数
+     * @details 释放全部内存块
+     */
+    ~EpochArena();
+
+    /**
+     * @brief 分配内存
+     * @param size 字节数
+     * @param align 对齐字节数（2的幂）
+     * @return void* 内存地址，生命周期至下次reset
+     */
+    void *allocate(std::size_t size, std::size_t align = alignof(std::max_align_t));
+
+    /**
+     * @brief 在内存池中构造对象
+     * @param args 构造参数
+     * @return T* 对象指针，生命周期至下次reset
+     */
+    template<typename T, typename... Args>
+    T *create(Args &&... args)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "EpochArena只能创建平凡析构类型");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 复位内存池
+     * @details 回收当前历元全部分配，内存块保留复用
+     */
+    void reset();
+
+    /**
+     * @brief 获取统计信息
+     * @return const Stats& 统计信息
+     */
+    const Stats &stats() const { return m_stats; }
+
+private:
+    Q_DISABLE_COPY(EpochArena)
+
+    /**
+     * @struct Block
+     * @brief 内存块
+     */
+    struct Block {
+        char *data;        // 内存块起始地址
+        std::size_t size;  // 内存块大小
+    };
+
+    std::size_t m_blockSize;   // 默认内存块大小
+    QVector<Block> m_blocks;   // 已申请的内存块
+    int m_current = 0;         // 当前使用的内存块序号
+    std::size_t m_offset = 0;  // 当前内存块已用偏移
+    Stats m_stats;             // 统计信息
+};
+
+#endif // EPOCHARENA_H
@@ -0,0 +1,341 @@
+﻿#include "EventLog.h"
+#include <QDateTime>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+static_assert(sizeof(LogEvent) == 96 && sizeof(LogEvent) % sizeof(quint64) == 0,
+              "LogEvent must be a whole number of 64-bit words");
+static_assert(std::is_trivially_copyable<LogEvent>::value, "LogEvent must be trivially copyable");
+
+/**
+ * @brief 构造函数实现
+ */
+EventLog::EventLog()
+    : m_writeIndex(0)
+{
+    for (Slot &slot : m_slots) {
+        slot.seq.store(0, std::memory_order_relaxed);
+        for (std::atomic<quint64> &word : slot.words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief 获取实例实现
+ */
+EventLog &EventLog::instance()
+{
+    static EventLog log;
+    return log;
+}
+
+/**
+ * @brief 写入事件（数值字段）实现
+ */
+void EventLog::record(Source source, Code code, std::initializer_list<qint64> args, int channel)
+{
+    LogEvent event;
+    fill(event, source, code, args, channel);
+    std::memset(event.detail, 0, sizeof(event.detail));
+    publish(event);
+}
+
+/**
+ * @brief 写入事件（数值字段+附加文本）实现
+ */
+void EventLog::record(Source source, Code code, const QString &detail, std::initializer_list<qint64> args, int channel)
+{
+    // 转码在占用槽位之前完成，缩短槽位处于写入中的时间
+    const QByteArray utf8 = detail.toUtf8();
+    int length = qMin(utf8.size(), static_cast<int>(sizeof(LogEvent::detail)) - 1);
+    // 截断时不拆分多字节字符
+    while (length > 0 && length < utf8.size() && (static_cast<uchar>(utf8.at(length)) & 0xC0) == 0x80) {
+        --length;
+    }
+
+    LogEvent event;
+    fill(event, source, code, args, channel);
+    std::memset(event.detail, 0, sizeof(event.detail));
+    std::memcpy(event.detail, utf8.constData(), static_cast<std::size_t>(length));
+    publish(event);
+}
+
+/**
+ * @brief 填写事件公共字段实现
+ */
+void EventLog::fill(LogEvent &event, Source source, Code code, std::initializer_list<qint64> args, int channel)
+{
+    event.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    event.code = static_cast<quint16>(code);
+    event.source = static_cast<quint8>(source);
+    event.level = static_cast<quint8>(levelOf(code));
+    event.channel = static_cast<quint8>(channel);
+    std::memset(event.reserved, 0, sizeof(event.reserved));
+
+    int i = 0;
+    for (qint64 value : args) {
+        if (i >= 4) {
+            break;
+        }
+        event.args[i++] = value;
+    }
+    for (; i < 4; ++i) {
+        event.args[i] = 0;
+    }
+}
+
+/**
+ * @brief 分配槽位并写入事件实现
+ * @details 事件在调用方栈上填写完毕后再占用槽位，槽位处于写入中的时间只有逐字存储。
+ *          槽位以CAS占用：同一槽位上一圈的写入仍在进行时等待其完成（仅在一次写入期间环形缓冲区被写满一圈时发生），
+ *          槽位已被更新一圈的写入方占用时放弃本条（读取方按覆盖计入丢失），
+ *          避免迟到的写入方回退seq并以旧内容覆盖新记录
+ */
+void EventLog::publish(const LogEvent &event)
+{
+    quint64 words[kEventWords];
+    std::memcpy(words, &event, sizeof(words));
+
+    const quint64 index = m_writeIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = m_slots[index & (kCapacity - 1)];
+    const quint64 writing = 2 * index + 1;
+
+    // 标记写入中，读取方据此丢弃被覆盖的槽位
+    quint64 seq = slot.seq.load(std::memory_order_relaxed);
+    for (;;) {
+        if (seq >= writing) {
+            return;
+        }
+        if (seq & 1) {
+            std::this_thread::yield();
+            seq = slot.seq.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (slot.seq.compare_exchange_weak(seq, writing, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (int i = 0; i < kEventWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+}
+
+/**
+ * @brief 读取事件实现
+ */
+int EventLog::read(quint64 &cursor, LogEvent *out, int maxCount, quint64 *dropped) const
+{
+    const quint64 end = m_writeIndex.load(std::memory_order_acquire);
+    quint64 lost = 0;
+
+    // 读取方落后超过一圈，跳过已被覆盖的部分
+    if (end - cursor > static_cast<quint64>(kCapacity)) {
+        lost += end - kCapacity - cursor;
+        cursor = end - kCapacity;
+    }
+
+    int count = 0;
+    while (cursor < end && count < maxCount) {
+        const Slot &slot = m_slots[cursor & (kCapacity - 1)];
+        const quint64 expected = 2 * cursor + 2;
+        const quint64 seq = slot.seq.load(std::memory_order_acquire);
+        if (seq < expected) {
+            // 写入尚未完成，下次再读
+            break;
+        }
+        if (seq == expected) {
+            quint64 words[kEventWords];
+            for (int i = 0; i < kEventWords; ++i) {
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) == expected) {
+                std::memcpy(&out[count], words, sizeof(words));
+                ++count;
+                ++cursor;
+                continue;
+            }
+        }
+
+        // 读取期间被覆盖
+        ++lost;
+        ++cursor;
+    }
+
+    if (dropped) {
+        *dropped = lost;
+    }
+    return count;
+}
+
+/**
+ * @brief 事件码对应级别实现
+ */
+EventLog::Level EventLog::levelOf(Code code)
+{
+    switch (code) {
+    case Code::UnsupportedType:
+    case Code::StartFailed:
+    case Code::FileOpenFailed:
+    case Code::FileReadFailed:
+    case Code::TcpError:
+    case Code::SerialOpenFailed:
+    case Code::SerialConfigFailed:
+    case Code::SerialError:
+    case Code::AppExportFailed:
+        return Level::Error;
+    case Code::FilePathEmpty:
+    case Code::TcpDisconnected:
+    case Code::SerialPortEmpty:
+    case Code::AppBadTcpAddress:
+    case Code::AppNoSource:
+    case Code::FusionInconsistent:
+    case Code::FusionDisputed:
+    case Code::FusionSourceConflict:
+        return Level::Warning;
+    default:
+        return Level::Info;
+    }
+}
+
+/**
+ * @brief 来源名称实现
+ */
+QString EventLog::sourceName(const LogEvent &event)
+{
+    QString name;
+    switch (static_cast<Source>(event.source)) {
+    case Source::Communicator:
+        name = "Communicator";
+        break;
+    case Source::SerialReader:
+        name = "SerialReader";
+        break;
+    case Source::App:
+        name = "App";
+        break;
+    case Source::Fusion:
+        name = "Fusion";
+        break;
+    default:
+        name = QString("Source%1").arg(event.source);
+        break;
+    }
+
+    if (event.channel > 0) {
+        name += QString("#%1").arg(event.channel);
+    }
+    return name;
+}
+
+/**
+ * @brief 格式化事件描述实现
+ */
+QString EventLog::describe(const LogEvent &event)
+{
+    const QString detail = QString::fromUtf8(event.detail);
+    const qint64 *a = event.args;
+
+    switch (static_cast<Code>(event.code)) {
+    case Code::UnsupportedType:
+        return QString("不支持的通讯类型：%1").arg(a[0]);
+    case Code::StartFailed:
+        return QString("启动%1模式失败").arg(a[0]);
+    case Code::Stopped:
+        return "通讯已停止";
+    case Code::ResourcesReleased:
+        return "释放所有资源";
+
+    case Code::FileInit:
+        return "初始化文件通讯";
+    case Code::FilePathEmpty:
+        return "文件路径为空";
+    case Code::FileOpenFailed:
+        return QString("文件打开失败：%1（错误码%2）").arg(detail).arg(a[0]);
+    case Code::FileStarted:
+        return QString("文件模式启动成功，文件：%1").arg(detail);
+    case Code::FileEnd:
+        return "文件读取完毕";
+    case Code::FileReadFailed:
+        return QString("文件读取失败：%1（错误码%2）").arg(detail).arg(a[0]);
+
+    case Code::TcpInit:
+        return "初始化Tcp通讯";
+    case Code::TcpConnected:
+        return QString("TCP客户端连接成功：%1:%2").arg(detail).arg(a[0]);
+    case Code::TcpDisconnected:
+        return "TCP客户端已断开连接";
+    case Code::TcpError:
+        return QString("TCP客户端错误：%1（错误码%2）").arg(detail).arg(a[0]);
+
+    case Code::SerialInit:
+        return "初始化串口通讯";
+    case Code::SerialPortEmpty:
+        return "串口号为空";
+    case Code::SerialOpenFailed:
+        return QString("串口打开失败：%1（错误码%2）").arg(detail).arg(a[0]);
+    case Code::SerialConfigFailed:
+        return QString("串口参数设置失败：%1（错误码%2）").arg(detail).arg(a[0]);
+    case Code::SerialStarted: {
+        static const char *const parities[] = {"无", "?", "偶", "奇", "空格", "标记"};
+        static const char *const stopBits[] = {"?", "1", "2", "1.5"};
+        static const char *const flows[] = {"无", "硬件", "软件"};
+        const qint64 parity = a[2];
+        const qint64 stop = a[3] / 10;
+        const qint64 flow = a[3] % 10;
+        return QString("串口启动成功，端口：%1，波特率：%2，数据位：%3，校验：%4，停止位：%5，流控：%6")
+                .arg(detail).arg(a[0]).arg(a[1])
+                .arg(parity >= 0 && parity <= 5 ? parities[parity] : "?")
+                .arg(stop >= 0 && stop <= 3 ? stopBits[stop] : "?")
+                .arg(flow >= 0 && flow <= 2 ? flows[flow] : "?");
+    }
+    case Code::SerialError:
+        return QString("串口错误：%1（错误码%2）").arg(detail).arg(a[0]);
+    case Code::SerialDispatchLatency:
+        return QString("串口读取→分发延迟统计：%1块，平均%2us，最小%3us，最大%4us")
+                .arg(a[0]).arg(a[1] / 1000.0, 0, 'f', 1)
+                .arg(a[2] / 1000.0, 0, 'f', 1).arg(a[3] / 1000.0, 0, 'f', 1);
+
+    case Code::FusionInconsistent:
+        return QString("数据源%1改正数与多数不一致：卫星%2，电文类型%3，历元%4")
+                .arg(a[0]).arg(a[1]).arg(a[2]).arg(a[3]);
+    case Code::FusionSummary:
+        return QString("数据源%1：收到%2条，首先到达%3条，不一致%4条")
+                .arg(a[0]).arg(a[1]).arg(a[2]).arg(a[3]);
+    case Code::FusionDisputed:
+        return QString("改正数平票无法判定：卫星%1，电文类型%2，历元%3，各取值%4票")
+                .arg(a[0]).arg(a[1]).arg(a[2]).arg(a[3]);
+    case Code::FusionSourceConflict:
+        return QString("数据源%1同一历元给出不同取值，已撤回其投票：卫星%2，电文类型%3，历元%4")
+                .arg(a[0]).arg(a[1]).arg(a[2]).arg(a[3]);
+
+    case Code::AppExportFailed:
+        return QString("改正数时效数据导出失败：%1").arg(detail);
+    case Code::AppBadTcpAddress:
+        return "TCP地址格式应为host:port";
+    case Code::AppNoSource:
+        return "未指定数据源（--file/--tcp/--serial）";
+    case Code::AppRxSummary:
+        return QString("累计接收%1字节").arg(a[0]);
+    }
+
+    return QString("未知事件%1：%2,%3,%4,%5 %6")
+            .arg(event.code).arg(a[0]).arg(a[1]).arg(a[2]).arg(a[3]).arg(detail);
+}
+
+/**
+ * @brief 格式化日志行实现
+ */
+QString EventLog::format(const LogEvent &event)
+{
+    return QString("[%1] 【%2】%3")
+            .arg(QDateTime::fromMSecsSinceEpoch(event.timestampMs).toString("yyyy-MM-dd hh:mm:ss"))
+            .arg(sourceName(event))
+            .arg(describe(event));
+}
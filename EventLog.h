@@ -0,0 +1,213 @@
+﻿#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <QtGlobal>
+#include <QString>
+#include <atomic>
+#include <initializer_list>
+
+/**
+ * @struct LogEvent
+ * @brief 结构化日志记录（定长96字节）
+ * @details 记录时只写入事件码、来源与数值字段，不做字符串格式化；
+ *          显示或持久化时再由EventLog::describe按事件码格式化。
+ *          持久化文件即为LogEvent的原样顺序排列（本机字节序），可直接按结构体解析
+ */
+struct LogEvent {
+    qint64 timestampMs;  // 事件时刻（UTC毫秒）
+    quint16 code;        // 事件码（EventLog::Code）
+    quint8 source;       // 事件来源（EventLog::Source）
+    quint8 level;        // 事件级别（EventLog::Level）
+    quint8 channel;      // 通道号（多数据源时区分通讯器，默认0）
+    quint8 reserved[3];  // 保留（对齐）
+    qint64 args[4];      // 数值字段，含义由事件码决定
+    char detail[48];     // 附加文本（UTF-8，以0结尾，仅低频事件使用，如错误描述）
+};
+
+/**
+ * @class EventLog
+ * @brief 无锁结构化日志环形缓冲区，替代逐条格式化的字符串日志
+ * @details 进程内唯一实例。多线程可同时调用record写入（原子递增写序号后以CAS占用槽位，槽位序号标记完成），
+ *          环满后覆盖最早记录；读取方（界面/无界面运行器）按各自游标定期read，
+ *          只对实际显示或保存的记录进行格式化
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class EventLog
+{
+public:
+    /**
+     * @enum Source
+     * @brief 事件来源
+     */
+    enum class Source : quint8 {
+        Communicator = 0,   // 通讯器
+        SerialReader = 1,   // 串口读取线程
+        App = 2,            // 应用层（界面/无界面运行器）
+        Fusion = 3          // 多数据源改正数融合
+    };
+
+    /**
+     * @enum Level
+     * @brief 事件级别
+     */
+    enum class Level : quint8 {
+        Info = 0,
+        Warning = 1,
+        Error = 2
+    };
+
+    /**
+     * @enum Code
+     * @brief 事件码，args/detail含义见各项注释
+     */
+    enum class Code : quint16 {
+        // 通用
+        UnsupportedType = 1,    // 不支持的通讯类型：args[0]=类型
+        StartFailed,            // 启动失败：args[0]=类型
+        Stopped,                // 通讯已停止
+        ResourcesReleased,      // 释放所有资源
+
+        // 文件模式
+        FileInit = 100,         // 初始化文件通讯
+        FilePathEmpty,          // 文件路径为空
+        FileOpenFailed,         // 文件打开失败：args[0]=QFileDevice::FileError，detail=错误描述
+        FileStarted,            // 文件模式启动成功：detail=文件名
+        FileEnd,                // 文件读取完毕
+        FileReadFailed,         // 文件读取失败：args[0]=QFileDevice::FileError，detail=错误描述
+
+        // TCP模式
+        TcpInit = 200,          // 初始化TCP通讯
+        TcpConnected,           // 连接成功：args[0]=端口，detail=IP
+        TcpDisconnected,        // 已断开连接
+        TcpError,               // 连接错误：args[0]=QAbstractSocket::SocketError，detail=错误描述
+
+        // 串口模式
+        SerialInit = 300,       // 初始化串口通讯
+        SerialPortEmpty,        // 串口号为空
+        SerialOpenFailed,       // 打开失败：args[0]=QSerialPort::SerialPortError，detail=错误描述
+        SerialConfigFailed,     // 参数设置失败：args[0]=QSerialPort::SerialPortError，detail=错误描述
+        SerialStarted,          // 启动成功：args[0]=波特率，args[1]=数据位，args[2]=校验位，args[3]=停止位*10+流控，detail=串口号
+        SerialError,            // 串口错误：args[0]=QSerialPort::SerialPortError，detail=错误描述
+        SerialDispatchLatency,  // 读取线程到分发延迟统计：args[0]=块数，args[1]=平均ns，args[2]=最小ns，args[3]=最大ns
+
+        // 多数据源融合
+        FusionInconsistent = 400, // 数据源不一致：args[0]=数据源序号，args[1]=卫星号，args[2]=电文类型，args[3]=历元（BDT天内秒）
+        FusionSummary,          // 数据源统计：args[0]=数据源序号，args[1]=收到电文数，args[2]=首先到达数，args[3]=不一致数
+        FusionDisputed,         // 平票无法判定：args[0]=卫星号，args[1]=电文类型，args[2]=历元（BDT天内秒），args[3]=每个取值的票数
+        FusionSourceConflict,   // 数据源同历元自相矛盾：args[0]=数据源序号，args[1]=卫星号，args[2]=电文类型，args[3]=历元（BDT天内秒）
+
+        // 应用层
+        AppExportFailed = 900,  // 改正数时效数据导出失败：detail=文件名
+        AppBadTcpAddress,       // TCP地址格式错误
+        AppNoSource,            // 未指定数据源
+        AppRxSummary            // 累计接收：args[0]=字节数
+    };
+
+    /**
+     * @brief 获取进程内唯一实例
+     * @return EventLog& 实例
+     */
+    static EventLog &instance();
+
+    /**
+     * @brief 写入一条事件（数值字段）
+     * @param source 来源
+     * @param code 事件码
+     * @param args 数值字段（最多4个）
+     * @param channel 通道号
+     * @details 无锁、无堆分配，可在任意线程的热路径中调用
+     */
+    void record(Source source, Code code, std::initializer_list<qint64> args = {}, int channel = 0);
+
+    /**
+     * @brief 写入一条事件（数值字段+附加文本）
+     * @param source 来源
+     * @param code 事件码
+     * @param detail 附加文本（UTF-8截断至47字节）
+     * @param args 数值字段（最多4个）
+     * @param channel 通道号
+     * @details 附加文本需转码，仅用于低频事件
+     */
+    void record(Source source, Code code, const QString &detail, std::initializer_list<qint64> args = {}, int channel = 0);
+
+    /**
+     * @brief 读取事件
+     * @param cursor 读取游标（输入为下一条待读序号，返回时更新），初始为0
+     * @param out 输出缓冲区
+     * @param maxCount 最多读取条数
+     * @param dropped 输出：因环形缓冲区覆盖而丢失的条数（可为nullptr）
+     * @return int 实际读取条数
+     */
+    int read(quint64 &cursor, LogEvent *out, int maxCount, quint64 *dropped = nullptr) const;
+
+    /**
+     * @brief 当前写序号
+     * @return quint64 已写入（含进行中）的事件总数，可作为新读取方的起始游标
+     */
+    quint64 writeIndex() const { return m_writeIndex.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 格式化事件描述（不含时间与来源）
+     * @param event 事件
+     * @return QString 描述文本
+     */
+    static QString describe(const LogEvent &event);
+
+    /**
+     * @brief 格式化完整日志行
+     * @param event 事件
+     * @return QString 日志行（"[时间] 【来源】描述"）
+     */
+    static QString format(const LogEvent &event);
+
+    /**
+     * @brief 事件来源名称
+     * @param event 事件
+     * @return QString 来源名称（多通道时附带通道号）
+     */
+    static QString sourceName(const LogEvent &event);
+
+    /**
+     * @brief 事件码对应的级别
+     * @param code 事件码
+     * @return Level 级别
+     */
+    static Level levelOf(Code code);
+
+private:
+    EventLog();
+    Q_DISABLE_COPY(EventLog)
+
+    /**
+     * @brief 填写事件公共字段
+     * @param event 待填写的事件（调用方栈上）
+     */
+    static void fill(LogEvent &event, Source source, Code code, std::initializer_list<qint64> args, int channel);
+
+    /**
+     * @brief 分配槽位并写入事件
+     * @param event 已填写的事件
+     */
+    void publish(const LogEvent &event);
+
+    static const int kEventWords = sizeof(LogEvent) / sizeof(quint64); // 单条事件的64位字数
+
+    /**
+     * @struct Slot
+     * @brief 环形缓冲区槽位
+     * @details seq为2*index+1表示写入中，2*index+2表示写入完成，只增不减（迟到的写入方不回退）；
+     *          事件内容按64位字以relaxed原子操作读写，读取方与覆盖写入的写入方并发访问同一槽位时
+     *          不构成数据竞争，读取到的撕裂副本由seq复核丢弃
+     */
+    struct Slot {
+        std::atomic<quint64> seq;
+        std::atomic<quint64> words[kEventWords];
+    };
+
+    static const int kCapacity = 4096;          // 槽位数（2的幂）
+    Slot m_slots[kCapacity];                    // 环形缓冲区
+    std::atomic<quint64> m_writeIndex;          // 下一个写序号
+};
+
+#endif // EVENTLOG_H
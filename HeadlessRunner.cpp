@@ -0,0 +1,312 @@
+﻿#include "HeadlessRunner.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QTextStream>
+#include <cstring>
+
+/**
+ * @brief 构造函数实现
+ * @param parent 父对象
+ */
+HeadlessRunner::HeadlessRunner(QObject *parent)
+    : QObject(parent)
+    , m_communicator(new Communicator(this))
+    , m_monitor(new CorrectionMonitor(4096, this))
+{
+    m_exportTimer = new QTimer(this);
+    connect(m_exportTimer, &QTimer::timeout, this, &HeadlessRunner::onExportTimerTimeout);
+
+    // 日志读取定时器：结构化事件在此格式化输出
+    m_logTimer = new QTimer(this);
+    m_logTimer->setInterval(100);
+    connect(m_logTimer, &QTimer::timeout, this, &HeadlessRunner::drainLog);
+    m_logTimer->start();
+
+    m_durationTimer = new QTimer(this);
+    m_durationTimer->setSingleShot(true);
+    connect(m_durationTimer, &QTimer::timeout, m_communicator, &Communicator::stopCommunication);
+
+    // 通讯器信号
+    connect(m_communicator, &Communicator::dataReady, this, &HeadlessRunner::onDataReady);
+    connect(m_communicator, &Communicator::stateChanged, this, &HeadlessRunner::onStateChanged);
+}
+
+/**
+ * @brief 判断是否请求无界面模式实现
+ */
+bool HeadlessRunner::isRequested(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 解析命令行并启动通讯实现
+ * @param arguments 命令行参数
+ * @return 启动结果
+ */
+bool HeadlessRunner::start(const QStringList &arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("B2b卫星数据接收（无界面模式）");
+    parser.addHelpOption();
+
+    QCommandLineOption headlessOpt("headless", "无界面模式运行");
+    QCommandLineOption fileOpt("file", "文件模式：数据文件路径", "path");
+    QCommandLineOption blockSizeOpt("block-size", "文件模式：每次读取字节数（默认1024）", "bytes", "1024");
+    QCommandLineOption intervalOpt("interval", "文件模式：读取间隔ms（默认100）", "ms", "100");
+    QCommandLineOption tcpOpt("tcp", "TCP客户端模式：服务器地址", "host:port");
+    QCommandLineOption serialOpt("serial", "串口模式：串口号", "port");
+    QCommandLineOption baudOpt("baud", "串口模式：波特率（默认9600）", "rate", "9600");
+    QCommandLineOption dataBitsOpt("databits", "串口模式：数据位5~8（默认8）", "bits", "8");
+    QCommandLineOption parityOpt("parity", "串口模式：校验位none/even/odd/space/mark（默认none）", "parity", "none");
+    QCommandLineOption stopBitsOpt("stopbits", "串口模式：停止位1/1.5/2（默认1）", "bits", "1");
+    QCommandLineOption flowOpt("flow", "串口模式：流控none/hw/sw（默认none）", "flow", "none");
+    QCommandLineOption bufferOpt("serial-buffer", "串口模式：串口读缓冲KB（默认0=不限）", "kb", "0");
+    QCommandLineOption exportOpt("monitor-export", "改正数时效监视数据导出CSV路径（周期追加新样本）", "path");
+    QCommandLineOption exportIntervalOpt("export-interval", "定时导出间隔s（默认60，0=仅结束时导出）", "sec", "60");
+    QCommandLineOption durationOpt("duration", "运行时长s（默认0=直到数据源结束）", "sec", "0");
+    QCommandLineOption eventLogOpt("event-log", "结构化事件日志保存路径（LogEvent原样追加）", "path");
+    QCommandLineOption logLevelOpt("log-level", "标准输出日志级别info/warning/error（默认info）", "level", "info");
+    QCommandLineOption soakOpt("soak", "浸泡测试：合成运行时长（小时），不连接数据源", "hours");
+    QCommandLineOption soakSpeedOpt("soak-speed", "浸泡测试：加速倍率（默认100）", "x", "100");
+    QCommandLineOption soakSatsOpt("soak-sats", "浸泡测试：合成卫星数（默认60）", "n", "60");
+    QCommandLineOption soakReportOpt("soak-report", "浸泡测试：报告间隔（合成分钟，默认10）", "min", "10");
+    QCommandLineOption soakToleranceOpt("soak-tolerance", "浸泡测试：允许的RSS增长KB（默认1024）", "kb", "1024");
+    QCommandLineOption soakWarmupOpt("soak-warmup", "浸泡测试：预热时长（合成分钟，默认10），合成时长需长于预热", "min", "10");
+    QCommandLineOption soakSourcesOpt("soak-sources", "浸泡测试：合成数据源数，大于1时经多数据源融合（默认1）", "n", "1");
+    parser.addOptions({headlessOpt, fileOpt, blockSizeOpt, intervalOpt, tcpOpt,
+                       serialOpt, baudOpt, dataBitsOpt, parityOpt, stopBitsOpt, flowOpt, bufferOpt,
+                       exportOpt, exportIntervalOpt, durationOpt, eventLogOpt, logLevelOpt,
+                       soakOpt, soakSpeedOpt, soakSatsOpt, soakReportOpt, soakToleranceOpt, soakWarmupOpt, soakSourcesOpt});
+    parser.process(arguments);
+
+    // 日志输出级别与事件日志文件
+    const QString logLevel = parser.value(logLevelOpt).toLower();
+    m_logLevel = logLevel == "error" ? EventLog::Level::Error
+               : logLevel == "warning" ? EventLog::Level::Warning
+               : EventLog::Level::Info;
+    if (parser.isSet(eventLogOpt)) {
+        m_eventLogFile = new QFile(parser.value(eventLogOpt), this);
+        if (!m_eventLogFile->open(QIODevice::WriteOnly | QIODevice::Append)) {
+            printLog("App", QString("事件日志文件打开失败：%1").arg(m_eventLogFile->errorString()));
+            delete m_eventLogFile;
+            m_eventLogFile = nullptr;
+        }
+    }
+
+    // 监视数据导出：本次运行从空文件开始，此后每次只追加新样本
+    m_exportPath = parser.value(exportOpt);
+    if (!m_exportPath.isEmpty() && QFile::exists(m_exportPath)) {
+        QFile::remove(m_exportPath);
+    }
+    const int exportIntervalSec = parser.value(exportIntervalOpt).toInt();
+    if (!m_exportPath.isEmpty() && exportIntervalSec > 0) {
+        m_exportTimer->start(exportIntervalSec * 1000);
+    }
+
+    // 浸泡测试：合成字节流经本机回环TCP送入浸泡测试自建的通讯器，不连接外部数据源
+    if (parser.isSet(soakOpt)) {
+        SoakTest::Options options;
+        options.hours = parser.value(soakOpt).toDouble();
+        options.speed = qMax(parser.value(soakSpeedOpt).toDouble(), 1.0);
+        options.satellites = qBound(1, parser.value(soakSatsOpt).toInt(), 63);
+        options.reportMinutes = qMax(parser.value(soakReportOpt).toInt(), 1);
+        options.toleranceKb = parser.value(soakToleranceOpt).toLongLong();
+        options.warmupMinutes = qMax(parser.value(soakWarmupOpt).toInt(), 1);
+        options.sources = qBound(1, parser.value(soakSourcesOpt).toInt(), 32);
+        if (options.hours * 60.0 <= options.warmupMinutes) {
+            printLog("App", QString("浸泡测试时长（%1分钟）须长于预热时长（%2分钟）")
+                     .arg(options.hours * 60.0).arg(options.warmupMinutes));
+            return false;
+        }
+
+        m_soakTest = new SoakTest(m_monitor, this);
+        connect(m_soakTest, &SoakTest::report, this, &HeadlessRunner::onSoakReport);
+        connect(m_soakTest, &SoakTest::finished, this, &HeadlessRunner::onSoakFinished);
+        m_soakTest->start(options);
+        return true;
+    }
+
+    // 改正数解码尚未接入通讯数据通路，实时数据源下监视器无样本
+    if (!m_exportPath.isEmpty()) {
+        printLog("App", "提示：解码模块尚未接入，实时数据源下改正数时效监视数据为空（仅--soak产生样本）");
+    }
+
+    // 构建配置
+    Communicator::Config config;
+    Communicator::CommunicationType type;
+    if (parser.isSet(fileOpt)) {
+        type = Communicator::CommunicationType::File;
+        config.filePath = parser.value(fileOpt);
+        config.readBlockSize = parser.value(blockSizeOpt).toInt();
+        config.readInterval = parser.value(intervalOpt).toInt();
+    } else if (parser.isSet(tcpOpt)) {
+        type = Communicator::CommunicationType::TcpClient;
+        const QStringList hostPort = parser.value(tcpOpt).split(':');
+        if (hostPort.size() != 2) {
+            EventLog::instance().record(EventLog::Source::App, EventLog::Code::AppBadTcpAddress);
+            drainLog();
+            return false;
+        }
+        config.tcpIp = hostPort.at(0);
+        config.tcpPort = static_cast<quint16>(hostPort.at(1).toUInt());
+    } else if (parser.isSet(serialOpt)) {
+        type = Communicator::CommunicationType::SerialPort;
+        config.serialPortName = parser.value(serialOpt);
+        config.baudRate = parser.value(baudOpt).toInt();
+        config.dataBits = static_cast<QSerialPort::DataBits>(qBound(5, parser.value(dataBitsOpt).toInt(), 8));
+
+        const QString parity = parser.value(parityOpt).toLower();
+        config.parity = parity == "even" ? QSerialPort::EvenParity
+                      : parity == "odd" ? QSerialPort::OddParity
+                      : parity == "space" ? QSerialPort::SpaceParity
+                      : parity == "mark" ? QSerialPort::MarkParity
+                      : QSerialPort::NoParity;
+
+        const QString stopBits = parser.value(stopBitsOpt);
+        config.stopBits = stopBits == "2" ? QSerialPort::TwoStop
+                        : stopBits == "1.5" ? QSerialPort::OneAndHalfStop
+                        : QSerialPort::OneStop;
+
+        const QString flow = parser.value(flowOpt).toLower();
+        config.flowControl = flow == "hw" ? QSerialPort::HardwareControl
+                           : flow == "sw" ? QSerialPort::SoftwareControl
+                           : QSerialPort::NoFlowControl;
+
+        config.serialReadBufferSize = parser.value(bufferOpt).toLongLong() * 1024;
+    } else {
+        EventLog::instance().record(EventLog::Source::App, EventLog::Code::AppNoSource);
+        drainLog();
+        return false;
+    }
+
+    // 启动通讯
+    if (!m_communicator->startCommunication(type, config)) {
+        drainLog();
+        return false;
+    }
+
+    const int durationSec = parser.value(durationOpt).toInt();
+    if (durationSec > 0) {
+        m_durationTimer->start(durationSec * 1000);
+    }
+    return true;
+}
+
+// ========== 通讯器信号槽函数 ==========
+void HeadlessRunner::onDataReady(const QByteArray &rawData)
+{
+    m_rxBytes += static_cast<quint64>(rawData.size());
+}
+
+void HeadlessRunner::onStateChanged(bool isRunning)
+{
+    if (isRunning) {
+        m_started = true;
+        return;
+    }
+
+    // 启动失败在start中返回，这里只处理运行后的停止
+    if (m_started) {
+        EventLog::instance().record(EventLog::Source::App, EventLog::Code::AppRxSummary,
+                                    {static_cast<qint64>(m_rxBytes)});
+        finish(0);
+    }
+}
+
+// ========== 浸泡测试 ==========
+void HeadlessRunner::onSoakReport(const QString &msg)
+{
+    printLog("SoakTest", msg);
+}
+
+void HeadlessRunner::onSoakFinished(bool passed)
+{
+    finish(passed ? 0 : 2);
+}
+
+// ========== 日志输出 ==========
+void HeadlessRunner::drainLog()
+{
+    LogEvent events[kLogBatch];
+    quint64 dropped = 0;
+    int count = 0;
+    do {
+        count = EventLog::instance().read(m_logCursor, events, kLogBatch, &dropped);
+        if (dropped > 0) {
+            printLog("App", QString("日志缓冲区溢出，丢失%1条事件").arg(dropped));
+        }
+
+        // 原样保存，不做格式化
+        if (m_eventLogFile && count > 0) {
+            m_eventLogFile->write(reinterpret_cast<const char *>(events),
+                                  static_cast<qint64>(sizeof(LogEvent)) * count);
+        }
+
+        // 仅格式化需要输出的事件
+        for (int i = 0; i < count; ++i) {
+            if (events[i].level >= static_cast<quint8>(m_logLevel)) {
+                printLine(EventLog::format(events[i]));
+            }
+        }
+    } while (count == kLogBatch);
+
+    if (m_eventLogFile) {
+        m_eventLogFile->flush();
+    }
+}
+
+// ========== 定时导出 ==========
+void HeadlessRunner::onExportTimerTimeout()
+{
+    exportMonitor();
+}
+
+void HeadlessRunner::printLog(const QString &source, const QString &msg)
+{
+    printLine(QString("[%1] 【%2】%3")
+              .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"))
+              .arg(source).arg(msg));
+}
+
+void HeadlessRunner::printLine(const QString &line)
+{
+    QTextStream out(stdout);
+    out << line << '\n';
+}
+
+void HeadlessRunner::exportMonitor()
+{
+    if (m_exportPath.isEmpty()) {
+        return;
+    }
+
+    if (!m_monitor->appendCsv(m_exportPath)) {
+        EventLog::instance().record(EventLog::Source::App, EventLog::Code::AppExportFailed,
+                                    QFileInfo(m_exportPath).fileName());
+    }
+}
+
+void HeadlessRunner::finish(int exitCode)
+{
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+
+    m_exportTimer->stop();
+    m_durationTimer->stop();
+    exportMonitor();
+    drainLog();
+    m_logTimer->stop();
+
+    // 退出事件循环（在下一轮事件循环中生效）
+    QTimer::singleShot(0, [exitCode]() { QCoreApplication::exit(exitCode); });
+}
@@ -0,0 +1,107 @@
+﻿#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QFile>
+
+#include "Communicator.h"
+#include "CorrectionMonitor.h"
+#include "SoakTest.h"
+#include "EventLog.h"
+
+/**
+ * @class HeadlessRunner
+ * @brief 无界面运行器，通过命令行参数驱动通讯层，适用于服务器/长期值守场景
+ * @details 使用--headless启动时由main创建，结构化事件按--log-level格式化输出到标准输出，
+ *          并可通过--event-log原样保存；
+ *          改正数时效监视数据按--export-interval周期及结束时增量追加到CSV；
+ *          使用--soak时不连接外部数据源，改为经本机回环TCP运行合成数据浸泡测试
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class HeadlessRunner : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     */
+    explicit HeadlessRunner(QObject *parent = nullptr);
+
+    /**
+     * @brief 判断命令行是否请求无界面模式
+     * @param argc 参数个数
+     * @param argv 参数列表
+     * @return bool 包含--headless返回true
+     * @details 需在创建QApplication之前调用
+     */
+    static bool isRequested(int argc, char *argv[]);
+
+    /**
+     * @brief 解析命令行并启动通讯
+     * @param arguments 命令行参数（QCoreApplication::arguments()）
+     * @return bool 启动成功返回true，参数错误或启动失败返回false
+     */
+    bool start(const QStringList &arguments);
+
+private slots:
+    // 通讯器信号槽函数
+    void onDataReady(const QByteArray &rawData);
+    void onStateChanged(bool isRunning);
+
+    // 定时导出槽函数
+    void onExportTimerTimeout();
+
+    // 日志读取槽函数：读取EventLog中的新事件，保存并输出
+    void drainLog();
+
+    // 浸泡测试槽函数
+    void onSoakReport(const QString &msg);
+    void onSoakFinished(bool passed);
+
+private:
+    /**
+     * @brief 输出一行日志到标准输出
+     * @param source 日志来源
+     * @param msg 日志内容
+     */
+    void printLog(const QString &source, const QString &msg);
+
+    /**
+     * @brief 输出一行文本到标准输出
+     * @param line 文本
+     */
+    void printLine(const QString &line);
+
+    /**
+     * @brief 导出改正数时效监视数据
+     */
+    void exportMonitor();
+
+    /**
+     * @brief 结束运行
+     * @param exitCode 进程退出码
+     */
+    void finish(int exitCode);
+
+    Communicator *m_communicator;       // 通讯器核心对象
+    CorrectionMonitor *m_monitor;       // 改正数时效监视器
+    QTimer *m_exportTimer;              // 定时导出定时器
+    QTimer *m_durationTimer;            // 运行时长定时器
+    QTimer *m_logTimer;                 // 日志读取定时器
+    QFile *m_eventLogFile = nullptr;    // 结构化事件日志文件（仅--event-log时创建）
+    quint64 m_logCursor = 0;            // EventLog读取游标
+    EventLog::Level m_logLevel = EventLog::Level::Info; // 标准输出日志级别
+    SoakTest *m_soakTest = nullptr;     // 浸泡测试（仅--soak时创建）
+    QString m_exportPath;               // 监视数据导出路径（空=不导出）
+    quint64 m_rxBytes = 0;              // 累计接收字节数
+    bool m_started = false;             // 通讯是否曾进入运行状态
+    bool m_finished = false;            // 是否已结束
+
+    static const int kLogBatch = 256;   // 单次读取事件数
+};
+
+#endif // HEADLESSRUNNER_H
@@ -0,0 +1,125 @@
+﻿#include "SerialReader.h"
+#include "utils.h"
+#include "EventLog.h"
+
+/**
+ * @brief 构造函数实现
+ * @param parent 父对象
+ */
+SerialReader::SerialReader(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * @brief 析构函数实现
+ */
+SerialReader::~SerialReader()
+{
+    close();
+}
+
+/**
+ * @brief 打开串口实现
+ * @return 打开结果
+ */
+bool SerialReader::open()
+{
+    close();
+
+    // 单次读取上限，限制单个dataRead信号携带的数据量
+    m_chunkSize = m_settings.chunkSize > 0 ? m_settings.chunkSize : defaultChunkSize(m_settings.baudRate);
+
+    // 在工作线程中创建串口对象，使readyRead在本线程派发
+    m_serialPort = new QSerialPort(this);
+    m_serialPort->setPortName(m_settings.portName);
+    m_serialPort->setReadBufferSize(m_settings.portBufferSize);
+
+    // 打开串口（读写模式）
+    if (!m_serialPort->open(QIODevice::ReadWrite)) {
+        EventLog::instance().record(EventLog::Source::SerialReader, EventLog::Code::SerialOpenFailed,
+                                    m_serialPort->errorString(), {m_serialPort->error()}, m_settings.channel);
+        delete m_serialPort;
+        m_serialPort = nullptr;
+        return false;
+    }
+
+    // 部分平台需在打开后设置参数才生效
+    if (!m_serialPort->setBaudRate(m_settings.baudRate)
+            || !m_serialPort->setDataBits(m_settings.dataBits)
+            || !m_serialPort->setParity(m_settings.parity)
+            || !m_serialPort->setStopBits(m_settings.stopBits)
+            || !m_serialPort->setFlowControl(m_settings.flowControl)) {
+        EventLog::instance().record(EventLog::Source::SerialReader, EventLog::Code::SerialConfigFailed,
+                                    m_serialPort->errorString(), {m_serialPort->error()}, m_settings.channel);
+        m_serialPort->close();
+        delete m_serialPort;
+        m_serialPort = nullptr;
+        return false;
+    }
+
+    // 丢弃打开前残留在驱动中的数据
+    m_serialPort->clear(QSerialPort::Input);
+
+    // 绑定信号槽
+    connect(m_serialPort, &QSerialPort::readyRead, this, &SerialReader::onReadyRead);
+    connect(m_serialPort, QOverload<QSerialPort::SerialPortError>::of(&QSerialPort::errorOccurred),
+            this, &SerialReader::onError);
+
+    return true;
+}
+
+/**
+ * @brief 关闭串口实现
+ */
+void SerialReader::close()
+{
+    if (!m_serialPort) {
+        return;
+    }
+
+    m_serialPort->disconnect(this);
+    m_serialPort->close();
+    delete m_serialPort;
+    m_serialPort = nullptr;
+}
+
+// ========== 槽函数实现 ==========
+
+/**
+ * @brief 串口数据就绪槽函数
+ */
+void SerialReader::onReadyRead()
+{
+    if (!m_serialPort || !m_serialPort->isOpen()) {
+        return;
+    }
+
+    // 记录本批字节到达时刻
+    const qint64 rxTimeNs = Utils::steadyNowNs();
+
+    // 按块读取，直到串口无可读数据
+    while (m_serialPort->bytesAvailable() > 0) {
+        // 按实际可读字节数申请，避免read(maxSize)先按上限分配、小数据块长期占用整块容量
+        const QByteArray chunk = m_serialPort->read(qMin(m_serialPort->bytesAvailable(), m_chunkSize));
+        if (chunk.isEmpty()) {
+            break;
+        }
+        emit dataRead(chunk, rxTimeNs);
+    }
+}
+
+/**
+ * @brief 串口错误槽函数
+ * @param error 错误码
+ */
+void SerialReader::onError(QSerialPort::SerialPortError error)
+{
+    if (error == QSerialPort::NoError || !m_serialPort) {
+        return;
+    }
+
+    EventLog::instance().record(EventLog::Source::SerialReader, EventLog::Code::SerialError,
+                                m_serialPort->errorString(), {error}, m_settings.channel);
+    emit readerError(error);
+}
@@ -0,0 +1,112 @@
+﻿#ifndef SERIALREADER_H
+#define SERIALREADER_H
+
+#include <QObject>
+#include <QSerialPort>
+#include <QByteArray>
+
+/**
+ * @class SerialReader
+ * @brief 串口读取工作对象，运行于独立线程中，负责高波特率下的串口数据接收
+ * @details 由Communicator创建并moveToThread到专用线程，QSerialPort在工作线程内创建，
+ *          readyRead在工作线程中处理，按块循环读取直到无可读数据，避免GUI线程阻塞导致的溢出；
+ *          每块数据附带到达时刻（Utils::steadyNowNs）发出，供通讯层统计读取线程到分发的延迟；
+ *          日志直接在本线程写入无锁的EventLog
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class SerialReader : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @struct Settings
+     * @brief 串口读取参数
+     */
+    struct Settings {
+        QString portName;            // 串口号（如"COM3"）
+        qint32 baudRate = 9600;      // 波特率（支持921600及以上的非标准波特率）
+        QSerialPort::DataBits dataBits = QSerialPort::Data8;             // 数据位
+        QSerialPort::Parity parity = QSerialPort::NoParity;             // 校验位
+        QSerialPort::StopBits stopBits = QSerialPort::OneStop;          // 停止位
+        QSerialPort::FlowControl flowControl = QSerialPort::NoFlowControl; // 流控
+        qint64 portBufferSize = 0;   // QSerialPort内部读缓冲大小（字节，0=不限制）
+        int chunkSize = 0;           // 单次读取上限（字节，0=按波特率自动选择）
+        int channel = 0;             // 通道号（写入本读取对象产生的事件，与所属Communicator一致）
+    };
+
+    /**
+     * @brief 按波特率选择单次读取上限
+     * @param baudRate 波特率
+     * @return int 读取块大小（460800及以上为16KB，否则4KB）
+     */
+    static int defaultChunkSize(qint32 baudRate) { return baudRate >= 460800 ? 16384 : 4096; }
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象（需moveToThread时应为nullptr）
+     */
+    explicit SerialReader(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     * @details 关闭串口并释放资源
+     */
+    ~SerialReader() override;
+
+    /**
+     * @brief 设置串口参数
+     * @param settings 串口参数
+     * @details 必须在工作线程启动之前调用
+     */
+    void setSettings(const Settings &settings) { m_settings = settings; }
+
+public slots:
+    /**
+     * @brief 打开串口
+     * @return bool 打开成功返回true，失败返回false
+     * @details 需在工作线程中调用（BlockingQueuedConnection）
+     */
+    bool open();
+
+    /**
+     * @brief 关闭串口
+     * @details 需在工作线程中调用（BlockingQueuedConnection）
+     */
+    void close();
+
+signals:
+    /**
+     * @brief 数据读取信号
+     * @param rawData 读取到的原始字节数据
+     * @param rxTimeNs 数据到达时刻（Utils::steadyNowNs）
+     */
+    void dataRead(const QByteArray &rawData, qint64 rxTimeNs);
+
+    /**
+     * @brief 串口错误信号
+     * @param error 串口错误码（QSerialPort::SerialPortError）
+     * @details 发生不可恢复错误时触发（错误已写入EventLog），由通讯层负责停止通讯
+     */
+    void readerError(int error);
+
+private slots:
+    /**
+     * @brief 串口数据就绪槽函数
+     * @details 按可读字节数（不超过单次读取上限）直接读取为QByteArray，直到串口无可读数据
+     */
+    void onReadyRead();
+
+    /**
+     * @brief 串口错误槽函数
+     * @param error 串口错误码
+     */
+    void onError(QSerialPort::SerialPortError error);
+
+private:
+    Settings m_settings;                  // 串口参数
+    QSerialPort *m_serialPort = nullptr;  // 串口对象（工作线程中创建）
+    qint64 m_chunkSize = 4096;            // 单次读取上限（字节）
+};
+
+#endif // SERIALREADER_H
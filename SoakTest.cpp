@@ -0,0 +1,576 @@
+﻿#include "SoakTest.h"
+#include "Communicator.h"
+#include "CorrectionMonitor.h"
+#include "CorrectionFusion.h"
+#include "EventLog.h"
+#include "utils.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtEndian>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+// ========== 堆分配计数 ==========
+// 仅以qmake CONFIG+=soak_heap_count构建时启用，在malloc层计数，Qt容器（QArrayData）的分配同样计入：
+// glibc下替换malloc/calloc/realloc后转调__libc_*；Windows下使用调试版CRT的分配钩子
+// （需与Qt库使用同一调试CRT）。普通构建不替换任何分配函数
+#if defined(B2B_SOAK_HEAP_COUNT)
+namespace {
+std::atomic<quint64> g_heapAllocations(0);
+}
+
+#if defined(__GLIBC__)
+#define B2B_HEAP_COUNT_AVAILABLE
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+
+void *malloc(std::size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, std::size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+#elif defined(Q_OS_WIN) && defined(_DEBUG)
+#define B2B_HEAP_COUNT_AVAILABLE
+#include <crtdbg.h>
+namespace {
+int countingAllocHook(int allocType, void *, size_t, int blockType, long, const unsigned char *, int)
+{
+    if ((allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC) && blockType != _CRT_BLOCK) {
+        g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return TRUE;
+}
+
+struct AllocHookInstaller {
+    AllocHookInstaller() { _CrtSetAllocHook(countingAllocHook); }
+} g_allocHookInstaller;
+}
+#endif
+#endif
+
+/**
+ * @brief 构造函数实现
+ * @param monitor 监视器
+ * @param parent 父对象
+ */
+SoakTest::SoakTest(CorrectionMonitor *monitor, QObject *parent)
+    : QObject(parent)
+    , m_monitor(monitor)
+{
+    m_tickTimer = new QTimer(this);
+    m_tickTimer->setInterval(10);
+    connect(m_tickTimer, &QTimer::timeout, this, &SoakTest::onTickTimeout);
+}
+
+/**
+ * @brief 析构函数实现
+ */
+SoakTest::~SoakTest()
+{
+    stopLinks();
+}
+
+/**
+ * @brief 累计堆分配次数实现
+ */
+qint64 SoakTest::heapAllocations()
+{
+#if defined(B2B_HEAP_COUNT_AVAILABLE)
+    return static_cast<qint64>(g_heapAllocations.load(std::memory_order_relaxed));
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief 启动浸泡测试实现
+ * @param options 测试参数
+ */
+void SoakTest::start(const Options &options)
+{
+    stopLinks();
+    m_options = options;
+    m_epoch = 0;
+    m_totalEpochs = static_cast<qint64>(options.hours * 3600.0);
+    m_epochBudget = 0.0;
+    m_baselineRss = -1;
+    m_peakRss = Utils::residentSetBytes();
+    m_lastReportHeap = heapAllocations();
+    m_lastReportEpoch = 0;
+    m_connected = 0;
+    m_fusedOutputs = 0;
+    m_fusedReplacements = 0;
+    m_fusedWrong = 0;
+    m_wrongSurvived = 0;
+    m_disputedKeys = 0;
+    m_wrongPending.clear();
+    m_majorityKeys.clear();
+
+    // 未经过预热的测试没有RSS基线，无法判断内存是否平稳
+    if (m_totalEpochs <= static_cast<qint64>(options.warmupMinutes) * 60) {
+        failRun(QString("合成时长%1分钟不长于预热时长%2分钟，无法判定内存是否平稳")
+              .arg(options.hours * 60.0).arg(options.warmupMinutes));
+        return;
+    }
+
+    if (options.sources > 1) {
+        m_fusion = new CorrectionFusion(this);
+        for (int i = 0; i < options.sources; ++i) {
+            m_fusion->addSource();
+        }
+        connect(m_fusion, &CorrectionFusion::fused, this, [this](const B2bCorrection &c, int, bool replacement) {
+            ++m_fusedOutputs;
+            if (replacement) {
+                ++m_fusedReplacements;
+            }
+            verifyFused(c);
+
+            // 合成历元与当前时间无关，以到达时刻作为历元登记，使龄期近似为0
+            m_monitor->recordCorrection(c.slot, c.msgType,
+                                        Utils::utcMsToBdtSod(Utils::steadyNsToUtcMs(c.rxTimeNs)), c.rxTimeNs);
+        });
+        connect(m_fusion, &CorrectionFusion::keyDisputed, this, [this]() {
+            ++m_disputedKeys;
+        });
+    }
+
+    // 本机回环服务器作为发送端
+    m_server = new QTcpServer(this);
+    connect(m_server, &QTcpServer::newConnection, this, &SoakTest::onNewConnection);
+    if (!m_server->listen(QHostAddress::LocalHost, 0)) {
+        failRun(QString("回环服务器启动失败：%1").arg(m_server->errorString()));
+        return;
+    }
+
+    // 每个数据源一个TcpClient模式的通讯器，多数据源时以通道号区分日志
+    m_links.resize(options.sources);
+    Communicator::Config config;
+    config.tcpIp = "127.0.0.1";
+    config.tcpPort = m_server->serverPort();
+    for (int i = 0; i < m_links.size(); ++i) {
+        Link &link = m_links[i];
+        link.decoder = new Decoder();
+        link.txBuffer.reserve(kFrameSize * options.satellites * 3);
+        link.rxBuffer.reserve(64 * 1024);
+        link.communicator = new Communicator(this);
+        link.communicator->setChannel(options.sources > 1 ? i + 1 : 0);
+        connect(link.communicator, &Communicator::dataReady, this, [this, i](const QByteArray &rawData) {
+            onLinkData(i, rawData);
+        });
+        if (!link.communicator->startCommunication(Communicator::CommunicationType::TcpClient, config)) {
+            failRun("回环通讯器启动失败");
+            return;
+        }
+    }
+
+    // 连接超时保护
+    QTimer::singleShot(5000, this, [this]() {
+        if (!m_running && m_connected < m_links.size() && m_server) {
+            failRun(QString("回环连接超时：%1/%2").arg(m_connected).arg(m_links.size()));
+        }
+    });
+
+    emit report(QString("浸泡测试开始：合成%1小时，加速%2倍，%3颗卫星，%4个数据源（回环TCP端口%5），预热%6分钟，初始RSS %7KB")
+                .arg(options.hours).arg(options.speed).arg(options.satellites)
+                .arg(m_links.size()).arg(m_server->serverPort()).arg(options.warmupMinutes)
+                .arg(m_peakRss / 1024));
+}
+
+// ========== 槽函数实现 ==========
+
+/**
+ * @brief 回环服务器新连接槽函数实现
+ */
+void SoakTest::onNewConnection()
+{
+    while (m_server && m_server->hasPendingConnections()) {
+        QTcpSocket *socket = m_server->nextPendingConnection();
+        if (m_connected >= m_links.size()) {
+            socket->close();
+            socket->deleteLater();
+            continue;
+        }
+        m_links[m_connected++].peer = socket;
+    }
+
+    if (!m_running && m_connected == m_links.size()) {
+        m_running = true;
+        m_tickTimer->start();
+    }
+}
+
+/**
+ * @brief 定时推进槽函数实现
+ */
+void SoakTest::onTickTimeout()
+{
+    m_epochBudget += m_options.speed * m_tickTimer->interval() / 1000.0;
+    while (m_epochBudget >= 1.0 && m_epoch < m_totalEpochs) {
+        m_epochBudget -= 1.0;
+        runEpoch();
+        ++m_epoch;
+
+        // 预热结束，记录RSS与堆分配基线
+        if (m_epoch == static_cast<qint64>(m_options.warmupMinutes) * 60) {
+            m_baselineRss = Utils::residentSetBytes();
+            m_baselineHeap = heapAllocations();
+        }
+
+        if (m_epoch % (static_cast<qint64>(qMax(m_options.reportMinutes, 1)) * 60) == 0) {
+            emitReport();
+        }
+    }
+
+    // 最后一个历元已发出，等待在途数据接收完毕
+    if (m_epoch >= m_totalEpochs) {
+        m_tickTimer->stop();
+        QTimer::singleShot(500, this, &SoakTest::finishRun);
+    }
+}
+
+/**
+ * @brief 结束测试实现
+ */
+void SoakTest::finishRun()
+{
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+
+    const qint64 endRss = Utils::residentSetBytes();
+    const qint64 endHeap = heapAllocations();
+    if (m_fusion) {
+        m_fusion->flush();
+        checkFusedErrors(true);
+        for (int i = 0; i < m_fusion->sourceCount(); ++i) {
+            const CorrectionFusion::SourceStats &stats = m_fusion->sourceStats(i);
+            EventLog::instance().record(EventLog::Source::Fusion, EventLog::Code::FusionSummary,
+                                        {i, static_cast<qint64>(stats.received),
+                                         static_cast<qint64>(stats.forwarded),
+                                         static_cast<qint64>(stats.inconsistent)});
+        }
+    }
+
+    // 各链路收发帧数须一致，否则数据通路未完整运行
+    quint64 txFrames = 0;
+    quint64 rxFrames = 0;
+    quint64 rxBytes = 0;
+    std::size_t arenaBlocks = 0;
+    std::size_t arenaCapacity = 0;
+    for (const Link &link : m_links) {
+        txFrames += link.txFrames;
+        rxFrames += link.rxFrames;
+        rxBytes += link.rxBytes;
+        arenaBlocks += link.decoder->arenaStats().blockAllocations;
+        arenaCapacity += link.decoder->arenaStats().capacity;
+    }
+    stopLinks();
+
+    const bool delivered = txFrames > 0 && rxFrames == txFrames;
+    const bool fusionCorrect = m_wrongSurvived == 0;
+    if (m_options.sources > 1) {
+        emit report(QString("融合校验：输出%1条（替换%2条），与真值不符%3条，存在多数时未纠正%4条，平票%5键")
+                    .arg(m_fusedOutputs).arg(m_fusedReplacements).arg(m_fusedWrong)
+                    .arg(m_wrongSurvived).arg(m_disputedKeys));
+    }
+    const qint64 growthKb = (endRss - m_baselineRss) / 1024;
+    const qint64 steadyEpochs = qMax<qint64>(m_totalEpochs - static_cast<qint64>(m_options.warmupMinutes) * 60, 1);
+    const bool memoryFlat = m_baselineRss >= 0 && growthKb <= m_options.toleranceKb;
+    const QString heapText = endHeap < 0 ? QString("未统计（需CONFIG+=soak_heap_count）")
+                           : QString("%1次（%2次/历元）").arg(endHeap - m_baselineHeap)
+                             .arg(static_cast<double>(endHeap - m_baselineHeap) / steadyEpochs, 0, 'f', 2);
+    emit report(QString("浸泡测试结束：%1历元，发送%2帧/接收%3帧（%4字节），RSS基线%5KB，结束%6KB，峰值%7KB，增长%8KB，"
+                        "稳定期堆分配%9，内存池申请%10块/容量%11KB，结论：%12")
+                .arg(m_epoch).arg(txFrames).arg(rxFrames).arg(rxBytes)
+                .arg(m_baselineRss / 1024).arg(endRss / 1024).arg(m_peakRss / 1024).arg(growthKb)
+                .arg(heapText)
+                .arg(static_cast<qint64>(arenaBlocks))
+                .arg(static_cast<qint64>(arenaCapacity / 1024))
+                .arg(!delivered ? "数据未完整接收" : !fusionCorrect ? "融合输出错误"
+                     : memoryFlat ? "内存平稳" : "内存增长超限"));
+    emit finished(delivered && fusionCorrect && memoryFlat);
+}
+
+// ========== 私有函数实现 ==========
+
+/**
+ * @brief 处理合成历元实现
+ * @details 钟差改正（类型4）每历元更新，轨道（类型2）与码偏差（类型3）每48历元按卫星错开更新；
+ *          合成电文帧（28字节，小端）：同步头0xB2 0x2B、卫星号u16、电文类型u8、IOD SSR u8、IOD Corr u8、保留u8、
+ *          历元u32（BDT天内秒）、轨道改正数i32×3与钟差改正数i32（0.1mm）
+ */
+void SoakTest::runEpoch()
+{
+    const qint64 epochSod = m_epoch % 86400;
+    const int sourceCount = m_links.size();
+    for (Link &link : m_links) {
+        link.txBuffer.resize(0);
+    }
+
+    for (int slot = 1; slot <= m_options.satellites; ++slot) {
+        const bool orbitDue = (m_epoch + slot) % 48 == 0;
+        const int types[] = {4, 2, 3};
+        for (int msgType : types) {
+            if (msgType != 4 && !orbitDue) {
+                continue;
+            }
+
+            uchar frame[kFrameSize];
+            frame[0] = 0xB2;
+            frame[1] = 0x2B;
+            qToLittleEndian<quint16>(static_cast<quint16>(slot), frame + 2);
+            frame[4] = static_cast<uchar>(msgType);
+            frame[5] = 1;
+            frame[6] = static_cast<uchar>((m_epoch / 48) % 8);
+            frame[7] = 0;
+            qToLittleEndian<quint32>(static_cast<quint32>(epochSod), frame + 8);
+            for (int component = 0; component < 4; ++component) {
+                qToLittleEndian<qint32>(syntheticValue(slot, msgType, epochSod, component), frame + 12 + component * 4);
+            }
+
+            // 多数据源：各数据源约10%缺失，最后一个数据源约0.5%钟差错误（+1m）；
+            // 3个及以上数据源时倒数第二个数据源另有约0.5%钟差错误（-1m），两种错误取值可能同时出现
+            int honestSent = 0;
+            bool corruptedSent = false;
+            for (int source = 0; source < sourceCount; ++source) {
+                Link &link = m_links[source];
+                if (sourceCount > 1) {
+                    m_random = m_random * 1664525u + 1013904223u;
+                    const quint32 roll = (m_random >> 8) % 1000;
+                    if (roll < 100) {
+                        continue;
+                    }
+                    int offset = 0;
+                    if (source == sourceCount - 1 && roll >= 995) {
+                        offset = 10000;
+                    } else if (sourceCount >= 3 && source == sourceCount - 2 && roll >= 995) {
+                        offset = -10000;
+                    }
+                    if (offset != 0) {
+                        uchar corrupted[kFrameSize];
+                        std::copy(frame, frame + kFrameSize, corrupted);
+                        qToLittleEndian<qint32>(syntheticValue(slot, msgType, epochSod, 3) + offset, corrupted + 24);
+                        link.txBuffer.append(reinterpret_cast<const char *>(corrupted), kFrameSize);
+                        ++link.txFrames;
+                        corruptedSent = true;
+                        continue;
+                    }
+                }
+                link.txBuffer.append(reinterpret_cast<const char *>(frame), kFrameSize);
+                ++link.txFrames;
+                ++honestSent;
+            }
+
+            // 每种错误取值至多来自一个数据源，正确取值至少两票即严格多于每种错误取值，融合输出最终必须为真值
+            if (corruptedSent && honestSent >= 2) {
+                m_majorityKeys.insert(verifyKey(slot, msgType, epochSod), m_epoch);
+            }
+        }
+    }
+
+    for (Link &link : m_links) {
+        if (link.peer && !link.txBuffer.isEmpty()) {
+            link.peer->write(link.txBuffer);
+        }
+    }
+
+    if (m_fusion) {
+        checkFusedErrors(false);
+    }
+}
+
+/**
+ * @brief 融合输出校验实现
+ */
+void SoakTest::verifyFused(const B2bCorrection &correction)
+{
+    const qint64 epochSod = static_cast<qint64>(correction.epochSod + 0.5) % 86400;
+    bool correct = true;
+    for (int component = 0; component < 4 && correct; ++component) {
+        const double truth = syntheticValue(correction.slot, correction.msgType, epochSod, component) * 1e-4;
+        const double value = component < 3 ? correction.orbit[component] : correction.clockC0;
+        correct = qAbs(value - truth) < 1e-6;
+    }
+
+    const quint64 key = verifyKey(correction.slot, correction.msgType, epochSod);
+    if (correct) {
+        m_wrongPending.remove(key);
+    } else {
+        ++m_fusedWrong;
+        m_wrongPending.insert(key, m_epoch);
+    }
+}
+
+/**
+ * @brief 判定错误输出实现
+ */
+void SoakTest::checkFusedErrors(bool all)
+{
+    for (QHash<quint64, qint64>::iterator it = m_wrongPending.begin(); it != m_wrongPending.end();) {
+        if (!all && m_epoch - it.value() < kVerifyWindow) {
+            ++it;
+            continue;
+        }
+        if (m_majorityKeys.contains(it.key())) {
+            ++m_wrongSurvived;
+        }
+        it = m_wrongPending.erase(it);
+    }
+
+    for (QHash<quint64, qint64>::iterator it = m_majorityKeys.begin(); it != m_majorityKeys.end();) {
+        if (all || m_epoch - it.value() >= kVerifyWindow) {
+            it = m_majorityKeys.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief 接收端数据处理实现
+ * @details 拆出完整帧，经解码层分配后登记到监视器或送入融合，余下不足一帧的字节保留
+ */
+void SoakTest::onLinkData(int source, const QByteArray &rawData)
+{
+    if (source < 0 || source >= m_links.size()) {
+        return;
+    }
+    Link &link = m_links[source];
+    const qint64 rxTimeNs = Utils::steadyNowNs();
+    link.rxBytes += static_cast<quint64>(rawData.size());
+    link.rxBuffer.append(rawData);
+
+    const uchar *data = reinterpret_cast<const uchar *>(link.rxBuffer.constData());
+    const int size = link.rxBuffer.size();
+    int pos = 0;
+    while (size - pos >= kFrameSize) {
+        if (data[pos] != 0xB2 || data[pos + 1] != 0x2B) {
+            ++pos;
+            continue;
+        }
+        const uchar *frame = data + pos;
+        pos += kFrameSize;
+
+        link.decoder->beginEpoch(qFromLittleEndian<quint32>(frame + 8));
+        B2bCorrection *correction = link.decoder->newCorrection(qFromLittleEndian<quint16>(frame + 2), frame[4]);
+        correction->iodSsr = frame[5];
+        correction->iodCorr = frame[6];
+        for (int i = 0; i < 3; ++i) {
+            correction->orbit[i] = qFromLittleEndian<qint32>(frame + 12 + i * 4) * 1e-4;
+        }
+        correction->clockC0 = qFromLittleEndian<qint32>(frame + 24) * 1e-4;
+        correction->rxTimeNs = rxTimeNs;
+        ++link.rxFrames;
+
+        if (m_fusion) {
+            m_fusion->submit(source, *correction);
+        } else {
+            m_monitor->recordCorrection(correction->slot, correction->msgType,
+                                        Utils::utcMsToBdtSod(Utils::steadyNsToUtcMs(rxTimeNs)), rxTimeNs);
+        }
+    }
+    link.rxBuffer.remove(0, pos);
+}
+
+/**
+ * @brief 输出报告实现
+ */
+void SoakTest::emitReport()
+{
+    const qint64 rss = Utils::residentSetBytes();
+    m_peakRss = qMax(m_peakRss, rss);
+
+    quint64 rxFrames = 0;
+    std::size_t highWater = 0;
+    for (const Link &link : m_links) {
+        rxFrames += link.rxFrames;
+        highWater = qMax(highWater, link.decoder->arenaStats().highWater);
+    }
+
+    const qint64 heap = heapAllocations();
+    const qint64 epochs = qMax<qint64>(m_epoch - m_lastReportEpoch, 1);
+    emit report(QString("浸泡测试：合成%1分钟，RSS %2KB，堆分配%3，已接收%4帧，内存池单历元峰值%5B")
+                .arg(m_epoch / 60).arg(rss / 1024)
+                .arg(heap < 0 ? QString("未统计")
+                              : QString("%1次/历元").arg(static_cast<double>(heap - m_lastReportHeap) / epochs, 0, 'f', 2))
+                .arg(rxFrames)
+                .arg(static_cast<qint64>(highWater)));
+
+    // 报告自身的字符串分配不计入下一周期
+    m_lastReportHeap = heapAllocations();
+    m_lastReportEpoch = m_epoch;
+}
+
+/**
+ * @brief 以失败结束测试实现
+ */
+void SoakTest::failRun(const QString &reason)
+{
+    m_running = false;
+    m_tickTimer->stop();
+    stopLinks();
+    emit report(QString("浸泡测试失败：%1").arg(reason));
+    emit finished(false);
+}
+
+/**
+ * @brief 停止通讯实现
+ */
+void SoakTest::stopLinks()
+{
+    for (Link &link : m_links) {
+        if (link.communicator) {
+            link.communicator->disconnect(this);
+            link.communicator->stopCommunication();
+            link.communicator->deleteLater();
+        }
+        if (link.peer) {
+            link.peer->close();
+            link.peer->deleteLater();
+        }
+        delete link.decoder;
+    }
+    m_links.clear();
+    m_connected = 0;
+
+    if (m_server) {
+        m_server->close();
+        m_server->deleteLater();
+        m_server = nullptr;
+    }
+    delete m_fusion;
+    m_fusion = nullptr;
+}
+
+/**
+ * @brief 合成电文真值实现
+ * @details 由卫星号/电文类型/历元确定的伪随机值，范围±1m
+ */
+qint32 SoakTest::syntheticValue(int slot, int msgType, qint64 epoch, int component)
+{
+    quint32 x = static_cast<quint32>(slot) * 73856093u
+              ^ static_cast<quint32>(msgType) * 19349663u
+              ^ static_cast<quint32>(epoch) * 83492791u
+              ^ static_cast<quint32>(component) * 2654435761u;
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    return static_cast<qint32>(x % 20001u) - 10000;
+}
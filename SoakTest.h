@@ -0,0 +1,216 @@
+﻿#ifndef SOAKTEST_H
+#define SOAKTEST_H
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <QByteArray>
+#include <QHash>
+
+#include "Decoder.h"
+
+class CorrectionMonitor;
+class CorrectionFusion;
+class Communicator;
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @class SoakTest
+ * @brief 长时浸泡测试，以合成PPP-B2b改正数字节流模拟多小时运行并监视内存
+ * @details 在本机回环地址启动TCP服务器，每个合成数据源对应一个TcpClient模式的Communicator：
+ *          按加速倍率逐历元生成合成电文帧写入各连接，接收端经Communicator::dataReady分块到达后
+ *          拆帧、经Decoder分配在历元内存池中，再登记到CorrectionMonitor，
+ *          覆盖长期运行时的数据块投递、通讯层日志、解码与监视数据通路。
+ *          多数据源（sources>1）时每个数据源随机缺失部分电文、最后两个数据源各自偶发不同的错误取值，
+ *          经CorrectionFusion融合后再登记到监视器，覆盖缺失补齐、多种取值计票与不一致判定通路；
+ *          每条融合输出（含替换输出）与合成真值比对，存在严格多数时错误取值未被纠正即判定失败。
+ *          周期性报告常驻内存（RSS）、堆分配次数与内存池统计，结束时比较预热后与结束时的RSS，
+ *          判断内存是否保持平稳。
+ *          堆分配次数需以qmake CONFIG+=soak_heap_count构建（在malloc层计数，含Qt容器分配），
+ *          普通构建不替换任何分配函数
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class SoakTest : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @struct Options
+     * @brief 浸泡测试参数
+     */
+    struct Options {
+        double hours = 4.0;       // 合成运行时长（小时），需长于预热时长
+        double speed = 100.0;     // 加速倍率（合成秒/实际秒）
+        int satellites = 60;      // 合成卫星数
+        int reportMinutes = 10;   // 报告间隔（合成分钟）
+        int warmupMinutes = 10;   // 预热时长（合成分钟），之后记录RSS基线
+        qint64 toleranceKb = 1024;// 允许的RSS增长（KB）
+        int sources = 1;          // 合成数据源数（>1时经融合输出）
+    };
+
+    /**
+     * @brief 构造函数
+     * @param monitor 改正数时效监视器（不转移所有权）
+     * @param parent 父对象
+     */
+    explicit SoakTest(CorrectionMonitor *monitor, QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     * @details 停止通讯并释放各数据源的解码层对象
+     */
+    ~SoakTest() override;
+
+    /**
+     * @brief 启动浸泡测试
+     * @param options 测试参数（合成时长不长于预热时长时直接以失败结束）
+     */
+    void start(const Options &options);
+
+    /**
+     * @brief 累计堆分配次数（malloc层）
+     * @return qint64 自进程启动以来的分配次数，未以soak_heap_count构建时返回-1
+     */
+    static qint64 heapAllocations();
+
+signals:
+    /**
+     * @brief 测试报告信号
+     * @param msg 报告内容
+     */
+    void report(const QString &msg);
+
+    /**
+     * @brief 测试结束信号
+     * @param passed true=数据完整接收、RSS增长在允许范围内且融合输出正确
+     */
+    void finished(bool passed);
+
+private slots:
+    /**
+     * @brief 定时推进槽函数
+     * @details 每次按加速倍率处理若干合成历元
+     */
+    void onTickTimeout();
+
+    /**
+     * @brief 回环服务器新连接槽函数
+     * @details 全部数据源连接后开始推进
+     */
+    void onNewConnection();
+
+    /**
+     * @brief 结束测试
+     * @details 最后一个历元发出后延迟调用，待在途数据接收完毕再统计
+     */
+    void finishRun();
+
+private:
+    /**
+     * @struct Link
+     * @brief 单个合成数据源的收发链路
+     */
+    struct Link {
+        Communicator *communicator = nullptr; // 接收端通讯器（TcpClient模式）
+        QTcpSocket *peer = nullptr;           // 发送端连接（服务器侧）
+        Decoder *decoder = nullptr;           // 接收端解码层对象
+        QByteArray txBuffer;                  // 发送帧缓冲（复用）
+        QByteArray rxBuffer;                  // 接收未拆帧字节（复用）
+        quint64 txFrames = 0;                 // 已发送帧数
+        quint64 rxFrames = 0;                 // 已接收帧数
+        quint64 rxBytes = 0;                  // 已接收字节数
+    };
+
+    /**
+     * @brief 处理一个合成历元
+     */
+    void runEpoch();
+
+    /**
+     * @brief 接收端数据处理
+     * @param source 数据源序号
+     * @param rawData Communicator::dataReady投递的数据块
+     */
+    void onLinkData(int source, const QByteArray &rawData);
+
+    /**
+     * @brief 融合输出与合成真值比对
+     * @param correction 融合输出
+     */
+    void verifyFused(const B2bCorrection &correction);
+
+    /**
+     * @brief 判定已移出融合时间窗的错误输出
+     * @param all true=判定全部（结束时）
+     * @details 错误输出在时间窗内未被替换，且该键当时存在严格多数的正确取值，计为未纠正
+     */
+    void checkFusedErrors(bool all);
+
+    /**
+     * @brief 融合校验键值
+     */
+    static quint64 verifyKey(int slot, int msgType, qint64 epochSod)
+    {
+        return (static_cast<quint64>((slot << 8) | (msgType & 0xFF)) << 20) | static_cast<quint64>(epochSod);
+    }
+
+    /**
+     * @brief 输出一次报告
+     */
+    void emitReport();
+
+    /**
+     * @brief 以失败结束测试
+     * @param reason 原因
+     */
+    void failRun(const QString &reason);
+
+    /**
+     * @brief 停止通讯并关闭回环服务器
+     */
+    void stopLinks();
+
+    /**
+     * @brief 合成电文真值
+     * @param slot 卫星号
+     * @param msgType 电文类型
+     * @param epoch 历元（BDT天内秒）
+     * @param component 分量（0~2轨道，3钟差）
+     * @return qint32 改正数（0.1mm）
+     */
+    static qint32 syntheticValue(int slot, int msgType, qint64 epoch, int component);
+
+    static const int kFrameSize = 28;       // 合成电文帧长度（字节）
+    static const int kVerifyWindow = 32;    // 融合校验判定延迟（历元，长于融合时间窗）
+
+    CorrectionMonitor *m_monitor;   // 改正数时效监视器
+    CorrectionFusion *m_fusion = nullptr; // 多数据源融合（仅sources>1时创建）
+    QTcpServer *m_server = nullptr; // 本机回环服务器（发送端）
+    QVector<Link> m_links;          // 各数据源链路
+    int m_connected = 0;            // 已接受的连接数
+    QTimer *m_tickTimer;            // 推进定时器
+    Options m_options;              // 测试参数
+    qint64 m_epoch = 0;             // 已处理的合成历元数（1历元=1秒）
+    qint64 m_totalEpochs = 0;       // 合成历元总数
+    double m_epochBudget = 0.0;     // 待处理的历元数（小数累计）
+    quint32 m_random = 1;           // 缺失/错误注入随机数状态
+    bool m_running = false;         // 是否运行中
+    qint64 m_baselineRss = -1;      // 预热后的RSS基线
+    qint64 m_peakRss = 0;           // RSS峰值
+    qint64 m_baselineHeap = 0;      // 预热后的堆分配计数
+    qint64 m_lastReportHeap = 0;    // 上次报告时的堆分配计数
+    qint64 m_lastReportEpoch = 0;   // 上次报告时的历元数
+
+    // 融合输出校验（仅sources>1）
+    quint64 m_fusedOutputs = 0;           // 融合输出条数
+    quint64 m_fusedReplacements = 0;      // 其中替换输出条数
+    quint64 m_fusedWrong = 0;             // 与真值不符的输出条数
+    quint64 m_wrongSurvived = 0;          // 存在严格多数时未被纠正的错误输出数
+    quint64 m_disputedKeys = 0;           // 平票键数
+    QHash<quint64, qint64> m_wrongPending;  // 当前输出错误的键 -> 发生时的历元数
+    QHash<quint64, qint64> m_majorityKeys;  // 注入错误且正确取值占严格多数的键 -> 生成时的历元数
+};
+
+#endif // SOAKTEST_H
@@ -1,9 +1,20 @@
-#include "mainwindow.h"
+﻿#include "mainwindow.h"
+#include "HeadlessRunner.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
+    // 无界面模式：仅运行通讯层，不创建窗口
+    if (HeadlessRunner::isRequested(argc, argv)) {
+        QCoreApplication a(argc, argv);
+        HeadlessRunner runner;
+        if (!runner.start(a.arguments())) {
+            return 1;
+        }
+        return a.exec();
+    }
+
     QApplication a(argc, argv);
     MainWindow w;
     w.show();
@@ -6,6 +6,7 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)  // 初始化UI对象
     , m_communicator(new Communicator(this))
+    , m_monitor(new CorrectionMonitor(4096, this))
 {
     // 加载Qt Designer设计的UI
     ui->setupUi(this);
@@ -16,6 +17,18 @@ MainWindow::MainWindow(QWidget *parent)
         ui->cbx_SerialPort->addItem(info.portName());
     }
 
+    // 限制日志/数据显示行数，超出后自动丢弃最早的行
+    ui->te_Log->document()->setMaximumBlockCount(kMaxLogLines);
+    ui->te_HexData->document()->setMaximumBlockCount(kMaxHexLines);
+    m_hexCursor = QTextCursor(ui->te_HexData->document());
+    m_hexLine.reserve(4096);
+
+    // 改正数龄期时间线绑定监视器
+    ui->timelineWidget->setMonitor(m_monitor);
+
+    // 波特率支持手动输入非标准值
+    ui->cbx_BaudRate->setValidator(new QIntValidator(1, 16000000, this));
+
     // 初始化按钮状态
     ui->btn_Start->setEnabled(true);
     ui->btn_Stop->setEnabled(false);
@@ -25,11 +38,22 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui->btn_Start, &QPushButton::clicked, this, &MainWindow::onStartBtnClicked);
     connect(ui->btn_Stop, &QPushButton::clicked, this, &MainWindow::onStopBtnClicked);
     connect(ui->btn_BrowseFile, &QPushButton::clicked, this, &MainWindow::onBrowseFileBtnClicked);
+    connect(ui->btn_ExportTimeline, &QPushButton::clicked, this, &MainWindow::onExportTimelineBtnClicked);
 
     // 通讯器信号
     connect(m_communicator, &Communicator::dataReady, this, &MainWindow::onDataReady);
-    connect(m_communicator, &Communicator::communicateRecoder, this, &MainWindow::onCommunicateRecoder);
     connect(m_communicator, &Communicator::stateChanged, this, &MainWindow::onStateChanged);
+
+    // 日志读取定时器：通讯层事件在此格式化显示
+    m_logTimer = new QTimer(this);
+    m_logTimer->setInterval(100);
+    connect(m_logTimer, &QTimer::timeout, this, &MainWindow::onLogTimerTimeout);
+    m_logTimer->start();
+
+    // 串口延迟状态栏刷新定时器
+    m_statusTimer = new QTimer(this);
+    m_statusTimer->setInterval(1000);
+    connect(m_statusTimer, &QTimer::timeout, this, &MainWindow::onStatusTimerTimeout);
 }
 
 MainWindow::~MainWindow()
@@ -70,26 +94,98 @@ void MainWindow::onBrowseFileBtnClicked()
     }
 }
 
+void MainWindow::onExportTimelineBtnClicked()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, "导出改正数时效数据", "correction_age.csv", "CSV文件 (*.csv)");
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    if (!m_monitor->exportCsv(filePath)) {
+        EventLog::instance().record(EventLog::Source::App, EventLog::Code::AppExportFailed,
+                                    QFileInfo(filePath).fileName());
+    }
+}
+
 // ========== 通讯器信号槽函数 ==========
 void MainWindow::onDataReady(const QByteArray &rawData)
 {
-    // 显示十六进制数据
-    QString hexData = rawData.toHex(' ').toUpper();
-    ui->te_HexData->append(QString("[%1] 接收数据：%2 (长度：%3字节)")
-                          .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"))
-                          .arg(hexData)
-                          .arg(rawData.size()));
+    static const char hexDigits[] = "0123456789ABCDEF";
+    static const QString lengthPrefix(" (长度：");
+    static const QString lengthSuffix("字节)");
+
+    // 时间戳前缀每秒格式化一次
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    if (nowMs / 1000 != m_hexStampSec) {
+        m_hexStampSec = nowMs / 1000;
+        m_hexStamp = QString("[%1] 接收数据：").arg(QDateTime::fromMSecsSinceEpoch(nowMs).toString("yyyy-MM-dd hh:mm:ss"));
+    }
+
+    // 整行写入复用的m_hexLine（大写十六进制，空格分隔），容量足够时不重新分配
+    m_hexLine.resize(0);
+    m_hexLine.append(m_hexStamp);
+    const int hexStart = m_hexLine.size();
+    m_hexLine.resize(hexStart + qMax(rawData.size() * 3 - 1, 0));
+    QChar *out = m_hexLine.data() + hexStart;
+    for (int i = 0; i < rawData.size(); ++i) {
+        const uchar byte = static_cast<uchar>(rawData.at(i));
+        if (i > 0) {
+            *out++ = QLatin1Char(' ');
+        }
+        *out++ = QLatin1Char(hexDigits[byte >> 4]);
+        *out++ = QLatin1Char(hexDigits[byte & 0x0F]);
+    }
+    m_hexLine.append(lengthPrefix);
+    char digits[16];
+    const int digitCount = qsnprintf(digits, sizeof(digits), "%d", rawData.size());
+    for (int i = 0; i < digitCount; ++i) {
+        m_hexLine.append(QLatin1Char(digits[i]));
+    }
+    m_hexLine.append(lengthSuffix);
+
+    // 以纯文本插入文档末尾（不经append的富文本判断）
+    m_hexCursor.movePosition(QTextCursor::End);
+    if (!ui->te_HexData->document()->isEmpty()) {
+        m_hexCursor.insertBlock();
+    }
+    m_hexCursor.insertText(m_hexLine);
 
     // 自动滚动到底部
     QScrollBar *scroll = ui->te_HexData->verticalScrollBar();
     scroll->setValue(scroll->maximum());
 }
 
-void MainWindow::onCommunicateRecoder(const QString &comMsg)
+void MainWindow::onLogTimerTimeout()
 {
-    ui->te_Log->append(QString("[%1] 【Communicator】%2")
-                      .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"))
-                      .arg(comMsg));
+    LogEvent events[kLogBatch];
+    quint64 dropped = 0;
+    int count = 0;
+    bool appended = false;
+
+    // 下拉框序号与EventLog::Level一致：全部/警告及以上/仅错误
+    const int minLevel = ui->cbx_LogLevel->currentIndex();
+
+    // 读到不足一批为止，避免事件较多时落后一圈被覆盖
+    do {
+        count = EventLog::instance().read(m_logCursor, events, kLogBatch, &dropped);
+        if (dropped > 0) {
+            ui->te_Log->append(QString("[%1] 【App】日志缓冲区溢出，丢失%2条事件")
+                              .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"))
+                              .arg(dropped));
+            appended = true;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            if (events[i].level >= minLevel) {
+                ui->te_Log->append(EventLog::format(events[i]));
+                appended = true;
+            }
+        }
+    } while (count == kLogBatch);
+
+    if (!appended) {
+        return;
+    }
 
     // 自动滚动到底部
     QScrollBar *scroll = ui->te_Log->verticalScrollBar();
@@ -102,6 +198,21 @@ void MainWindow::onStateChanged(bool isRunning)
     ui->btn_Start->setEnabled(!isRunning);
     ui->btn_Stop->setEnabled(isRunning);
 
+    // 串口模式下刷新延迟统计
+    if (isRunning && m_communicator->currentType() == Communicator::CommunicationType::SerialPort) {
+        m_statusTimer->start();
+    } else {
+        m_statusTimer->stop();
+    }
+}
+
+void MainWindow::onStatusTimerTimeout()
+{
+    const Communicator::DispatchLatencyStats stats = m_communicator->serialDispatchLatency();
+    ui->statusbar->showMessage(QString("串口：%1字节/%2块，读取→分发延迟 平均%3us 最大%4us")
+                               .arg(stats.bytes).arg(stats.chunks)
+                               .arg(stats.meanUs(), 0, 'f', 1)
+                               .arg(stats.maxNs / 1000.0, 0, 'f', 1));
 }
 
 // ========== 构建配置参数 ==========
@@ -121,10 +232,29 @@ Communicator::Config MainWindow::buildConfig()
     // 串口配置
     config.serialPortName = ui->cbx_SerialPort->currentText();
     config.baudRate = ui->cbx_BaudRate->currentText().toInt();
-    config.dataBits = QSerialPort::Data8;
-    config.parity = QSerialPort::NoParity;
-    config.stopBits = QSerialPort::OneStop;
-    config.flowControl = QSerialPort::NoFlowControl;
+    config.dataBits = static_cast<QSerialPort::DataBits>(QSerialPort::Data5 + ui->cbx_DataBits->currentIndex());
+
+    // 下拉框顺序：无/偶/奇/空格/标记
+    static const QSerialPort::Parity parities[] = {
+        QSerialPort::NoParity, QSerialPort::EvenParity, QSerialPort::OddParity,
+        QSerialPort::SpaceParity, QSerialPort::MarkParity
+    };
+    config.parity = parities[qBound(0, ui->cbx_Parity->currentIndex(), 4)];
+
+    // 下拉框顺序：1/1.5/2
+    static const QSerialPort::StopBits stopBits[] = {
+        QSerialPort::OneStop, QSerialPort::OneAndHalfStop, QSerialPort::TwoStop
+    };
+    config.stopBits = stopBits[qBound(0, ui->cbx_StopBits->currentIndex(), 2)];
+
+    // 下拉框顺序：无/硬件/软件
+    static const QSerialPort::FlowControl flowControls[] = {
+        QSerialPort::NoFlowControl, QSerialPort::HardwareControl, QSerialPort::SoftwareControl
+    };
+    config.flowControl = flowControls[qBound(0, ui->cbx_FlowControl->currentIndex(), 2)];
+
+    // 串口读缓冲（KB），单次读取块大小由串口读取线程按波特率选择
+    config.serialReadBufferSize = static_cast<qint64>(ui->spinSerialBufferSize->value()) * 1024;
 
     return config;
 }
@@ -6,11 +6,18 @@
 #include <QDateTime>
 #include <QScrollBar>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <QIntValidator>
+#include <QTimer>
+#include <QTextDocument>
+#include <QTextCursor>
 
 // 引入Qt Designer生成的UI头文件
 #include "ui_mainwindow.h"
 
 #include "Communicator.h"
+#include "CorrectionMonitor.h"
+#include "EventLog.h"
 
 class MainWindow : public QMainWindow
 {
@@ -25,12 +32,18 @@ private slots:
     void onStartBtnClicked();
     void onStopBtnClicked();
     void onBrowseFileBtnClicked();
+    void onExportTimelineBtnClicked();
 
     // 通讯器信号槽函数
     void onDataReady(const QByteArray &rawData);
-    void onCommunicateRecoder(const QString &comMsg);
     void onStateChanged(bool isRunning);
 
+    // 日志读取槽函数：读取EventLog中的新事件，按级别过滤后格式化显示
+    void onLogTimerTimeout();
+
+    // 状态栏刷新槽函数
+    void onStatusTimerTimeout();
+
 private:
     // 构建配置参数（根据选中的通讯类型）
     Communicator::Config buildConfig();
@@ -40,6 +53,30 @@ private:
 
     // 通讯器核心对象
     Communicator *m_communicator;
+
+    // 改正数时效监视器
+    CorrectionMonitor *m_monitor;
+
+    // 状态栏刷新定时器（串口延迟统计）
+    QTimer *m_statusTimer = nullptr;
+
+    // 日志读取定时器及EventLog读取游标
+    QTimer *m_logTimer = nullptr;
+    quint64 m_logCursor = 0;
+
+    // 十六进制显示：整行在复用的QString中拼接，经固定光标插入文档末尾；
+    // 时间戳每秒只格式化一次（文档自身保存文本的分配不在此列）
+    QString m_hexLine;
+    QString m_hexStamp;
+    qint64 m_hexStampSec = -1;
+    QTextCursor m_hexCursor;
+
+    // 日志/数据显示最大行数（长期运行时限制文档内存）
+    static const int kMaxLogLines = 2000;
+    static const int kMaxHexLines = 500;
+
+    // 单次读取日志事件数
+    static const int kLogBatch = 256;
 };
 
 #endif // MAINWINDOW_H
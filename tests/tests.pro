@@ -0,0 +1,6 @@
+# 单元测试（qmake && make check），每个测试为独立的控制台程序，直接编译所需的源文件
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    tst_eventlog \
+    tst_correctionfusion
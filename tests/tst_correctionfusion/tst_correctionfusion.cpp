@@ -0,0 +1,235 @@
+﻿#include <QtTest>
+#include <QVector>
+
+#include "CorrectionFusion.h"
+
+/**
+ * @class TestCorrectionFusion
+ * @brief CorrectionFusion投票规则测试
+ * @details 每个用例只覆盖一条规则：首条转发、按取值计票替换、平票争议、多种错误取值、
+ *          同一数据源自相矛盾撤回投票、过期丢弃
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class TestCorrectionFusion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void firstArrivalForwarded();
+    void majorityReplacesForwarded();
+    void tieIsDisputed();
+    void distinctValuesCountedSeparately();
+    void conflictingSourceWithdrawn();
+    void staleDropped();
+
+private:
+    /**
+     * @struct Output
+     * @brief 一次fused输出
+     */
+    struct Output {
+        double clockC0;
+        int source;
+        bool replacement;
+    };
+
+    /**
+     * @brief 构造电文（卫星1，钟差类型4）
+     */
+    static B2bCorrection correction(double epochSod, double clockC0);
+
+    /**
+     * @brief 创建融合对象并记录其全部输出
+     */
+    void setUp(CorrectionFusion &fusion, int sources);
+
+    QVector<Output> m_outputs;        // fused输出
+    QVector<int> m_inconsistent;      // sourceInconsistent的数据源序号
+    int m_disputed = 0;               // keyDisputed次数
+};
+
+B2bCorrection TestCorrectionFusion::correction(double epochSod, double clockC0)
+{
+    B2bCorrection c;
+    c.slot = 1;
+    c.msgType = 4;
+    c.epochSod = epochSod;
+    c.iodSsr = 1;
+    c.clockC0 = clockC0;
+    return c;
+}
+
+void TestCorrectionFusion::setUp(CorrectionFusion &fusion, int sources)
+{
+    m_outputs.clear();
+    m_inconsistent.clear();
+    m_disputed = 0;
+    for (int i = 0; i < sources; ++i) {
+        fusion.addSource();
+    }
+    connect(&fusion, &CorrectionFusion::fused, this, [this](const B2bCorrection &c, int source, bool replacement) {
+        m_outputs.append(Output{c.clockC0, source, replacement});
+    });
+    connect(&fusion, &CorrectionFusion::sourceInconsistent, this, [this](int source, int, int, double) {
+        m_inconsistent.append(source);
+    });
+    connect(&fusion, &CorrectionFusion::keyDisputed, this, [this](int, int, double) {
+        ++m_disputed;
+    });
+}
+
+/**
+ * @brief 首条电文立即转发，其余数据源的一致取值只计为重复
+ */
+void TestCorrectionFusion::firstArrivalForwarded()
+{
+    CorrectionFusion fusion;
+    setUp(fusion, 3);
+
+    fusion.submit(1, correction(100, 0.5));
+    QCOMPARE(m_outputs.size(), 1);
+    QCOMPARE(m_outputs[0].source, 1);
+    QCOMPARE(m_outputs[0].replacement, false);
+
+    fusion.submit(0, correction(100, 0.5));
+    fusion.submit(2, correction(100, 0.5));
+    fusion.submit(2, correction(100, 0.5));
+    fusion.flush();
+
+    QCOMPARE(m_outputs.size(), 1);
+    QCOMPARE(fusion.sourceStats(1).forwarded, quint64(1));
+    QCOMPARE(fusion.sourceStats(0).duplicates, quint64(1));
+    QCOMPARE(fusion.sourceStats(2).duplicates, quint64(2));
+    QVERIFY(m_inconsistent.isEmpty());
+    QCOMPARE(m_disputed, 0);
+}
+
+/**
+ * @brief 另一取值得票严格多于已转发值时替换输出，落败数据源在回收时记为不一致
+ */
+void TestCorrectionFusion::majorityReplacesForwarded()
+{
+    CorrectionFusion fusion;
+    setUp(fusion, 3);
+
+    fusion.submit(0, correction(100, 1.5));
+    fusion.submit(1, correction(100, 0.5));
+    QCOMPARE(m_outputs.size(), 1);
+    fusion.submit(2, correction(100, 0.5));
+
+    QCOMPARE(m_outputs.size(), 2);
+    QCOMPARE(m_outputs[1].clockC0, 0.5);
+    QCOMPARE(m_outputs[1].source, 1);
+    QCOMPARE(m_outputs[1].replacement, true);
+
+    fusion.flush();
+    QCOMPARE(m_inconsistent, QVector<int>({0}));
+    QCOMPARE(m_disputed, 0);
+}
+
+/**
+ * @brief 两个数据源各执一值：保持先到取值，记为争议键，不归咎任何数据源
+ */
+void TestCorrectionFusion::tieIsDisputed()
+{
+    CorrectionFusion fusion;
+    setUp(fusion, 2);
+
+    fusion.submit(0, correction(100, 1.5));
+    fusion.submit(1, correction(100, 0.5));
+    fusion.flush();
+
+    QCOMPARE(m_outputs.size(), 1);
+    QCOMPARE(m_outputs[0].clockC0, 1.5);
+    QVERIFY(m_inconsistent.isEmpty());
+    QCOMPARE(m_disputed, 1);
+    QCOMPARE(fusion.sourceStats(0).disputed, quint64(1));
+    QCOMPARE(fusion.sourceStats(1).disputed, quint64(1));
+}
+
+/**
+ * @brief 5个数据源：A给X、B给Y、C/D/E给Z，两种错误取值各自计票，最终输出Z，A与B记为不一致
+ */
+void TestCorrectionFusion::distinctValuesCountedSeparately()
+{
+    CorrectionFusion fusion;
+    setUp(fusion, 5);
+
+    fusion.submit(0, correction(100, 1.5));
+    fusion.submit(1, correction(100, -1.5));
+    fusion.submit(2, correction(100, 0.5));
+    QCOMPARE(m_outputs.size(), 1);
+    fusion.submit(3, correction(100, 0.5));
+    fusion.submit(4, correction(100, 0.5));
+
+    QCOMPARE(m_outputs.size(), 2);
+    QCOMPARE(m_outputs.last().clockC0, 0.5);
+    QCOMPARE(m_outputs.last().source, 2);
+    QCOMPARE(m_outputs.last().replacement, true);
+
+    fusion.flush();
+    QCOMPARE(m_inconsistent, QVector<int>({0, 1}));
+    QCOMPARE(m_disputed, 0);
+}
+
+/**
+ * @brief 同一数据源同历元给出不同取值：撤回其全部投票并单独上报，其后的电文不再计票
+ * @details A/D给X、B/C给Y，Y先获两票替换输出；C再给Z后撤回，Y只剩一票，X以两票重新替换
+ */
+void TestCorrectionFusion::conflictingSourceWithdrawn()
+{
+    CorrectionFusion fusion;
+    setUp(fusion, 4);
+
+    fusion.submit(0, correction(100, 1.5));
+    fusion.submit(1, correction(100, 0.5));
+    fusion.submit(2, correction(100, 0.5));
+    QCOMPARE(m_outputs.size(), 2);
+    QCOMPARE(m_outputs.last().clockC0, 0.5);
+
+    fusion.submit(3, correction(100, 1.5));
+    QCOMPARE(m_outputs.size(), 2);
+
+    fusion.submit(2, correction(100, 2.5));
+    QCOMPARE(m_inconsistent, QVector<int>({2}));
+    QCOMPARE(fusion.sourceStats(2).inconsistent, quint64(1));
+    QCOMPARE(m_outputs.size(), 3);
+    QCOMPARE(m_outputs.last().clockC0, 1.5);
+    QCOMPARE(m_outputs.last().replacement, true);
+
+    // 已撤回的数据源再给出原取值也不再计票
+    fusion.submit(2, correction(100, 0.5));
+    QCOMPARE(m_outputs.size(), 3);
+
+    fusion.flush();
+    QCOMPARE(m_inconsistent, QVector<int>({2, 1}));
+    QCOMPARE(m_disputed, 0);
+}
+
+/**
+ * @brief 移出时间窗的历元，以及早于该键已转发历元的电文均视为过期丢弃
+ */
+void TestCorrectionFusion::staleDropped()
+{
+    CorrectionFusion fusion;
+    setUp(fusion, 2);
+
+    // 时间桶已被16秒后的历元占用
+    fusion.submit(0, correction(100, 0.5));
+    fusion.submit(0, correction(116, 0.5));
+    fusion.submit(1, correction(100, 0.5));
+    QCOMPARE(fusion.sourceStats(1).stale, quint64(1));
+
+    // 时间桶空闲，但该键已转发更新的历元
+    fusion.submit(1, correction(110, 0.5));
+    QCOMPARE(fusion.sourceStats(1).stale, quint64(2));
+    QCOMPARE(m_outputs.size(), 2);
+
+    fusion.flush();
+    QVERIFY(m_inconsistent.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestCorrectionFusion)
+
+#include "tst_correctionfusion.moc"
@@ -0,0 +1,20 @@
+QT       += core testlib
+QT       -= gui
+
+CONFIG += c++11 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_correctionfusion
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_correctionfusion.cpp \
+    ../../CorrectionFusion.cpp \
+    ../../EventLog.cpp
+
+HEADERS += \
+    ../../CorrectionFusion.h \
+    ../../Decoder.h \
+    ../../EpochArena.h \
+    ../../EventLog.h
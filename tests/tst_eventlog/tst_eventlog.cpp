@@ -0,0 +1,126 @@
+﻿#include <QtTest>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "EventLog.h"
+
+/**
+ * @class TestEventLog
+ * @brief EventLog无锁环形缓冲区测试
+ * @details 多写入方并发写入、单读取方同时读取：读出的每条事件内容完整（无撕裂），
+ *          同一写入方的事件按写入顺序读出，读出条数与丢失条数之和等于写入总数。
+ *          以CONFIG+=sanitize_thread构建时同时由ThreadSanitizer检查数据竞争
+ * @author 江鑫海
+ * @date 2026-10-18
+ */
+class TestEventLog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void recordAndRead();
+    void concurrentWritersAndReader();
+};
+
+/**
+ * @brief 单线程写入读取：字段与附加文本原样读出
+ */
+void TestEventLog::recordAndRead()
+{
+    EventLog &log = EventLog::instance();
+    quint64 cursor = log.writeIndex();
+
+    log.record(EventLog::Source::SerialReader, EventLog::Code::SerialError, QString("设备已拔出"), {9}, 2);
+    log.record(EventLog::Source::Communicator, EventLog::Code::TcpConnected, {8888});
+
+    LogEvent events[4];
+    quint64 dropped = 0;
+    QCOMPARE(log.read(cursor, events, 4, &dropped), 2);
+    QCOMPARE(dropped, quint64(0));
+    QCOMPARE(cursor, log.writeIndex());
+
+    QCOMPARE(events[0].code, static_cast<quint16>(EventLog::Code::SerialError));
+    QCOMPARE(events[0].source, static_cast<quint8>(EventLog::Source::SerialReader));
+    QCOMPARE(events[0].channel, quint8(2));
+    QCOMPARE(events[0].args[0], qint64(9));
+    QCOMPARE(QString::fromUtf8(events[0].detail), QString("设备已拔出"));
+    QCOMPARE(events[1].args[0], qint64(8888));
+    QCOMPARE(events[1].args[1], qint64(0));
+    QCOMPARE(events[1].detail[0], '\0');
+}
+
+/**
+ * @brief 4个写入方与1个读取方并发
+ * @details 每条事件args[0]=写入方，args[1]=序号，args[2]/args[3]为由前两者导出的校验值，
+ *          读取方同时检查内容完整与同一写入方的顺序；写入量为环形缓冲区容量的数十倍，确保覆盖写入与读取并发
+ */
+void TestEventLog::concurrentWritersAndReader()
+{
+    static const int kWriters = 4;
+    static const qint64 kPerWriter = 200000;
+
+    EventLog &log = EventLog::instance();
+    const quint64 start = log.writeIndex();
+    std::atomic<int> running(kWriters);
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([w, &running]() {
+            for (qint64 i = 0; i < kPerWriter; ++i) {
+                EventLog::instance().record(EventLog::Source::App, EventLog::Code::AppRxSummary,
+                                            {w, i, ~i, w * 1000003LL + i}, w);
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    quint64 cursor = start;
+    quint64 readCount = 0;
+    quint64 droppedCount = 0;
+    quint64 torn = 0;
+    quint64 disordered = 0;
+    qint64 lastSeq[kWriters] = {-1, -1, -1, -1};
+    LogEvent events[256];
+
+    auto drain = [&]() {
+        quint64 dropped = 0;
+        const int count = log.read(cursor, events, 256, &dropped);
+        droppedCount += dropped;
+        for (int k = 0; k < count; ++k) {
+            const LogEvent &event = events[k];
+            const qint64 w = event.args[0];
+            const qint64 i = event.args[1];
+            if (w < 0 || w >= kWriters || event.args[2] != ~i || event.args[3] != w * 1000003LL + i
+                    || event.channel != w || event.code != static_cast<quint16>(EventLog::Code::AppRxSummary)) {
+                ++torn;
+                continue;
+            }
+            if (i <= lastSeq[w]) {
+                ++disordered;
+            }
+            lastSeq[w] = i;
+        }
+        readCount += static_cast<quint64>(count);
+        return count;
+    };
+
+    while (running.load(std::memory_order_acquire) > 0) {
+        drain();
+    }
+    for (std::thread &writer : writers) {
+        writer.join();
+    }
+    while (drain() > 0) {
+    }
+
+    QCOMPARE(torn, quint64(0));
+    QCOMPARE(disordered, quint64(0));
+    QCOMPARE(log.writeIndex() - start, quint64(kWriters * kPerWriter));
+    QCOMPARE(readCount + droppedCount, quint64(kWriters * kPerWriter));
+    QVERIFY(readCount > 0);
+}
+
+QTEST_APPLESS_MAIN(TestEventLog)
+
+#include "tst_eventlog.moc"
@@ -0,0 +1,17 @@
+QT       += core testlib
+QT       -= gui
+
+CONFIG += c++11 console testcase
+CONFIG -= app_bundle
+
+# 线程竞争检查：qmake CONFIG+=sanitizer CONFIG+=sanitize_thread
+TARGET = tst_eventlog
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_eventlog.cpp \
+    ../../EventLog.cpp
+
+HEADERS += \
+    ../../EventLog.h
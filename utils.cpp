@@ -1,6 +1,57 @@
-#include "utils.h"
+﻿#include "utils.h"
+#include <QDateTime>
+#include <chrono>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <cstdio>
+#include <unistd.h>
+#endif
 
 Utils::Utils()
 {
 
 }
+
+qint64 Utils::steadyNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+qint64 Utils::steadyNsToUtcMs(qint64 steadyNs)
+{
+    static const qint64 offsetNs = QDateTime::currentMSecsSinceEpoch() * 1000000LL - steadyNowNs();
+    return (steadyNs + offsetNs) / 1000000LL;
+}
+
+double Utils::utcMsToBdtSod(qint64 utcMs)
+{
+    const qint64 bdtMs = utcMs + static_cast<qint64>(kBdtMinusUtcSec) * 1000;
+    return (bdtMs % 86400000LL) / 1000.0;
+}
+
+qint64 Utils::residentSetBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.WorkingSetSize);
+    }
+    return -1;
+#elif defined(Q_OS_LINUX)
+    // /proc/self/statm第二项为常驻页数
+    long pages = 0;
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return -1;
+    }
+    const int fields = std::fscanf(statm, "%*s %ld", &pages);
+    std::fclose(statm);
+    return fields == 1 ? static_cast<qint64>(pages) * sysconf(_SC_PAGESIZE) : -1;
+#else
+    return -1;
+#endif
+}
@@ -1,11 +1,27 @@
-#ifndef UTILS_H
+﻿#ifndef UTILS_H
 #define UTILS_H
 
+#include <QtGlobal>
 
 class Utils
 {
 public:
     Utils();
+
+    // 单调时钟纳秒数（steady_clock），用于跨线程延迟测量
+    static qint64 steadyNowNs();
+
+    // 单调时钟纳秒数转换为UTC毫秒时间，使用首次调用时记录的UTC与单调时钟之差（此后的系统校时不影响结果）
+    static qint64 steadyNsToUtcMs(qint64 steadyNs);
+
+    // UTC毫秒时间（自1970-01-01）转换为北斗时（BDT）天内秒
+    static double utcMsToBdtSod(qint64 utcMs);
+
+    // 当前进程常驻内存（RSS/工作集，字节），不支持的平台返回-1
+    static qint64 residentSetBytes();
+
+    // 北斗时与UTC之差（秒，自2017-01-01起为4秒）
+    static const int kBdtMinusUtcSec = 4;
 };
 
 #endif // UTILS_H